@@ -0,0 +1,204 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <optional>
+#include <memory>
+
+#include "./datamodel/Misc.hpp"
+#include "./datamodel/Instance.hpp"
+#include "./datamodel/Heuristics.hpp"
+#include "./datamodel/Semantics.hpp"
+#include "./tools/BigUnsigned.hpp"
+#include "./tools/ProofWriter.hpp"
+#include "./tools/ModelSink.hpp"
+#include "./tools/SearchStatistics.hpp"
+
+using namespace std;
+
+class Preprocessor;
+
+/**
+ * Solves an instance by splitting it into the weakly connected components of its attack graph.
+ * The extensions of the instance are the Cartesian product of the extensions of its components. Thus, every component is solved on its own,
+ * the model counts are multiplied and the product is only enumerated if the models are printed
+ */
+class ComponentSolver
+{
+	private:
+		/**
+		 * The instance to solve
+		 */
+		Instance& instance;
+
+		/**
+		 * The semantics to use
+		 */
+		Semantics const& semantics;
+
+		/**
+		 * The heuristics to use
+		 */
+		Heuristics const& heuristics;
+
+		/**
+		 * The time at which time first model has been found
+		 */
+		chrono::time_point<chrono::high_resolution_clock>& firstModelTime;
+
+		/**
+		 * The number of models found, saturated at the largest unsigned long
+		 */
+		unsigned long& modelCount;
+
+		/**
+		 * Will be set to the exact number of models if they are only counted
+		 */
+		optional<BigUnsigned>& exactModelCount;
+
+		/**
+		 * The percentage of the search space that has been checked
+		 */
+		double& percentageSolved;
+
+		/**
+		 * The number of models to find or 0 for unlimited
+		 */
+		unsigned long& numberOfModels;
+
+		/**
+		 * Receives the found models
+		 */
+		ModelSink& modelSink;
+
+		/**
+		 * Indicates whether the models are passed to the model sink, otherwise they are only counted
+		 */
+		bool printModels;
+
+		/**
+		 * Indicates whether the strongly connected components should be guessed one after another in topological order
+		 */
+		bool const& sccRecursive;
+
+		/**
+		 * The percentage of clauses that are forgotten in each cycle
+		 */
+		double const& clForgetPercentage;
+
+		/**
+		 * The factor that the forget threshold increases per forget cycle
+		 */
+		double const& clGrowthRate;
+
+		/**
+		 * The file to which the proof is written to.
+		 */
+		std::unique_ptr<ProofWriter>& proofFile;
+
+		/**
+		 * For each component, the ids of the arguments it consists of in ascending order
+		 */
+		vector<vector<ID>> componentArguments;
+
+		/**
+		 * For each component, the ids of the attacks within it
+		 */
+		vector<vector<ID>> componentAttacks;
+
+		/**
+		 * For each component, the required arguments within it given by their id within the component
+		 */
+		vector<vector<pair<ID, Sign>>> componentRequiredArguments;
+
+		/**
+		 * For each argument by id, its id within its component
+		 */
+		vector<ID> localIds;
+
+		/**
+		 * For each component, its models given by the ids within the component of the arguments that are in. Only filled if models are passed to the model sink
+		 */
+		vector<vector<vector<ID>>> componentModels;
+
+		/**
+		 * If not null, the instance has been reduced and the models are passed as models of the original instance
+		 */
+		Preprocessor const* reconstruction = nullptr;
+
+		/**
+		 * The number of assignments that failed literal probing may do per component or 0 to disable it
+		 */
+		unsigned long probingBudget = 0;
+
+		/**
+		 * Indicates whether the solvers of the components should detect equivalent arguments
+		 */
+		bool detectEquivalences = false;
+
+		/**
+		 * Indicates whether the solvers of the components should propagate stability by counters
+		 */
+		bool useStabilityCounters = false;
+
+		/**
+		 * The counters of the searches of all components
+		 */
+		SearchStatistics statistics;
+
+	public:
+		/**
+		 * Create a new solver with the given instance
+		 */
+		ComponentSolver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, optional<BigUnsigned>& exactModelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, bool const& sccRecursive, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ProofWriter>& proofFile);
+
+		/**
+		 * Starts with solving process
+		 */
+		void solve();
+
+		/**
+		 * Passes the models as models of the original instance of the given preprocessor
+		 */
+		void setReconstruction(Preprocessor const* reconstruction);
+
+		/**
+		 * Enables failed literal probing in the solvers of the components with the given number of assignments, 0 disables it
+		 */
+		void setProbingBudget(unsigned long const& probingBudget);
+
+		/**
+		 * Enables the detection of equivalent arguments in the solvers of the components
+		 */
+		void setDetectEquivalences(bool const& detectEquivalences);
+
+		/**
+		 * Enables the propagation of stability by counters in the solvers of the components
+		 */
+		void setUseStabilityCounters(bool const& useStabilityCounters);
+
+		/**
+		 * {@return the counters of the searches of all components}
+		 */
+		SearchStatistics const& getStatistics() const;
+
+	private:
+		/**
+		 * Splits the instance into its components. Arguments that are not involved in any attack are collected into a single component
+		 */
+		void decompose();
+
+		/**
+		 * Solves the component with the given index and collects its models if they are printed
+		 * @param count Will be set to the number of models of the component
+		 * @param componentPercentageSolved Will be set to the percentage of the search space of the component that has been checked
+		 * @return false if the solver has been interrupted by a signal
+		 */
+		bool solveComponent(size_t const& index, unsigned long& count, double& componentPercentageSolved);
+
+		/**
+		 * Passes the product of the models of the components to the model sink, one combination at a time
+		 */
+		void enumerateProduct();
+};
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <chrono>
+
+#include "./datamodel/Misc.hpp"
+#include "./datamodel/Instance.hpp"
+#include "./tools/ModelSink.hpp"
+#include "./datamodel/Heuristics.hpp"
+
+using namespace std;
+
+class Preprocessor;
+
+/**
+ * Enumerates the stable extensions of instances whose supports contain at most Arity arguments, e.g. plain argumentation frameworks for Arity 1.
+ * The supports are stored inline and the attacks are indexed by flat adjacency arrays, such that propagation does not go through the generic clauses and stability watches.
+ * Every attack is a clause over at most Arity + 1 arguments, which is propagated by counters of the supporting arguments that are unassigned and out. The stability of an argument
+ * is propagated by the number of attacks on it that are not blocked. The search does not learn clauses, but uses conflict directed backjumping: every assignment records the
+ * rule that implied it, from which the decision levels a conflict depends on are traced. The search then jumps to the deepest of them, as the guesses in between do not
+ * affect the conflict. After a model, it backtracks chronologically to enumerate all extensions
+ */
+template <size_t Arity>
+class FixedAritySolver
+{
+	private:
+		/**
+		 * An attack with its supporting arguments. A self attack contains the attacked argument in its support
+		 */
+		struct Attack
+		{
+			/**
+			 * The attacked argument
+			 */
+			ID target;
+
+			/**
+			 * The number of supporting arguments
+			 */
+			unsigned char size;
+
+			/**
+			 * The supporting arguments, only the first size entries are valid
+			 */
+			array<ID, Arity> support;
+		};
+
+		/**
+		 * The rules by which an argument is assigned
+		 */
+		enum class ReasonType : unsigned char
+		{
+			/**
+			 * Guessed or assigned at dl 0
+			 */
+			Decision,
+
+			/**
+			 * Out as last unassigned supporting argument of an attack that is not blocked and whose target is in. The source is the attack
+			 */
+			LastMemberOut,
+
+			/**
+			 * Out as target of an attack whose supporting arguments are all in. The source is the attack
+			 */
+			TargetOut,
+
+			/**
+			 * In as all attacks on it are blocked
+			 */
+			Unattacked,
+
+			/**
+			 * In as supporting argument of the only attack that is not blocked on an out argument. The source is the out argument
+			 */
+			LiveAttackMemberIn
+		};
+
+		/**
+		 * The rule that assigned an argument, together with the attack or argument it has been applied to
+		 */
+		struct Reason
+		{
+			/**
+			 * The rule
+			 */
+			ReasonType type;
+
+			/**
+			 * The attack or argument the rule has been applied to, depending on the rule
+			 */
+			ID source;
+		};
+
+		/**
+		 * A guess that has been made
+		 */
+		struct Decision
+		{
+			/**
+			 * The size of the trail before the guess
+			 */
+			size_t trailPosition;
+
+			/**
+			 * The position of the guessed argument in the guess order
+			 */
+			ID position;
+
+			/**
+			 * Indicates whether the second value is tried
+			 */
+			bool isFlipped;
+
+			/**
+			 * The part of the search space that had been solved when the current value was guessed
+			 */
+			double solvedBefore;
+		};
+
+		/**
+		 * The instance to solve
+		 */
+		Instance& instance;
+
+		/**
+		 * The heuristics that determines the guess order
+		 */
+		Heuristics const& heuristics;
+
+		/**
+		 * The time at which time first model has been found
+		 */
+		chrono::time_point<chrono::high_resolution_clock>& firstModelTime;
+
+		/**
+		 * The number of models found
+		 */
+		unsigned long& modelCount;
+
+		/**
+		 * The percentage of the search space that has been checked
+		 */
+		double& percentageSolved;
+
+		/**
+		 * The number of models to find or 0 for unlimited
+		 */
+		unsigned long& numberOfModels;
+
+		/**
+		 * Receives the found models
+		 */
+		ModelSink& modelSink;
+
+		/**
+		 * Indicates whether the models are passed to the model sink, otherwise they are only counted
+		 */
+		bool printModels;
+
+		/**
+		 * If not null, the instance has been reduced and the models are passed as models of the original instance
+		 */
+		Preprocessor const* reconstruction = nullptr;
+
+		/**
+		 * The ids of the arguments that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> modelArguments;
+
+		/**
+		 * The ids of the arguments of the original instance that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> originalModelArguments;
+
+		/**
+		 * The attacks of the instance
+		 */
+		vector<Attack> attacks;
+
+		/**
+		 * For each argument, the index of its first attack in attacksOn. Contains one additional element marking the end of the last argument
+		 */
+		vector<size_t> attacksOnOffsets;
+
+		/**
+		 * The attacks on every argument
+		 */
+		vector<ID> attacksOn;
+
+		/**
+		 * For each argument, the index of its first attack in supportedAttacks. Contains one additional element marking the end of the last argument
+		 */
+		vector<size_t> supportedAttacksOffsets;
+
+		/**
+		 * The attacks every argument is a supporting argument of
+		 */
+		vector<ID> supportedAttacks;
+
+		/**
+		 * The value of each argument, 0 if unassigned, 1 if in and -1 if out
+		 */
+		vector<Sign> values;
+
+		/**
+		 * For each attack, the number of supporting arguments that are out. The attack is blocked iff this is not 0
+		 */
+		vector<unsigned char> outMembers;
+
+		/**
+		 * For each attack, the number of supporting arguments that are unassigned
+		 */
+		vector<unsigned char> unassignedMembers;
+
+		/**
+		 * For each argument, the number of attacks on it that are not blocked
+		 */
+		vector<ID> liveAttacks;
+
+		/**
+		 * The assigned arguments in the order of assignment
+		 */
+		vector<ID> trail;
+
+		/**
+		 * The index in the trail of the next assignment whose consequences are to be propagated
+		 */
+		size_t propagationPosition = 0;
+
+		/**
+		 * The ids of the arguments in the order they are guessed
+		 */
+		vector<ID> guessOrder;
+
+		/**
+		 * The value that is guessed first for every argument of guessOrder
+		 */
+		vector<Sign> guesses;
+
+		/**
+		 * The guesses that have been made, the guess at index i has dl i + 1
+		 */
+		vector<Decision> decisions;
+
+		/**
+		 * The position in guessOrder of the next argument to guess
+		 */
+		ID guessPosition = 0;
+
+		/**
+		 * The part of the search space that has been solved
+		 */
+		double solved = 0;
+
+		/**
+		 * For each assigned argument, its dl, i.e. the number of guesses when it was assigned
+		 */
+		vector<DL> levels;
+
+		/**
+		 * For each assigned argument, its index in the trail
+		 */
+		vector<size_t> trailPositions;
+
+		/**
+		 * For each assigned argument, the rule that assigned it
+		 */
+		vector<Reason> reasons;
+
+		/**
+		 * The argument whose assignment failed in the last conflict, as it already has the opposite value or the rule given by conflictReason has been violated
+		 */
+		ID conflictArgument;
+
+		/**
+		 * The rule that required the opposite value of conflictArgument in the last conflict
+		 */
+		Reason conflictReason;
+
+		/**
+		 * For each dl, the lower dls on which the failures of its values depend. Kept for all dls to avoid reallocation
+		 */
+		vector<vector<DL>> levelConflicts;
+
+		/**
+		 * For each dl, whether it has been added to the set that is currently computed. Member to avoid reallocation
+		 */
+		vector<bool> isLevelAdded;
+
+		/**
+		 * For each argument, the conflict analysis in which it has been visited last
+		 */
+		vector<unsigned long> visitedInAnalysis;
+
+		/**
+		 * The number of the current conflict analysis
+		 */
+		unsigned long analysisNumber = 0;
+
+		/**
+		 * The arguments whose reasons are still to be traced by the conflict analysis. Member to avoid reallocation
+		 */
+		vector<ID> analysisStack;
+
+	public:
+		FixedAritySolver(Instance& instance, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink);
+
+		/**
+		 * Enumerates the extensions
+		 */
+		void solve();
+
+		/**
+		 * Passes the models as models of the original instance of the given preprocessor
+		 */
+		void setReconstruction(Preprocessor const* reconstruction);
+
+	private:
+		/**
+		 * Assigns the given value to the given argument by the given rule unless it already has a value
+		 * @return false if the argument has already been assigned the opposite value, which is recorded as conflict
+		 */
+		bool assign(ID const& argument, Sign const& value, Reason const& reason);
+
+		/**
+		 * Records a conflict of the given argument with the given rule
+		 * @return false
+		 */
+		bool setConflict(ID const& argument, Reason const& reason);
+
+		/**
+		 * Adds the arguments whose assignments caused the given rule to assign the given argument to analysisStack. Blocked attacks are blocked by an argument out
+		 * before the given trail position
+		 */
+		void addAntecedents(ID const& argument, Reason const& reason, size_t const& trailPosition);
+
+		/**
+		 * Computes the dls of the guesses the last conflict depends on
+		 */
+		void analyzeConflict(vector<DL>& conflictLevels);
+
+		/**
+		 * Undoes the guesses above the deepest dl in the given set and tries the second value of its guess if it has not been tried yet. If both values failed, the
+		 * failures are combined and the search jumps further
+		 * @return false if no guess remains to be flipped, thus the search is finished
+		 */
+		bool backjump(vector<DL>& conflictLevels);
+
+		/**
+		 * Propagates the consequences of all assignments on the trail that have not been propagated yet
+		 * @return false if a conflict occurred
+		 */
+		bool propagate();
+
+		/**
+		 * Undoes all assignments after the given trail position
+		 */
+		void undo(size_t const& trailPosition);
+
+		/**
+		 * Assigns the unassigned supporting argument of the given attack, which is not blocked, has a single unassigned supporting argument and an attacked argument that
+		 * is in, to out
+		 */
+		void assignLastMember(ID const& attack);
+
+		/**
+		 * Assigns all supporting arguments of the only attack on the given argument that is not blocked to in
+		 * @return false if a conflict occurred
+		 */
+		bool assignLiveAttack(ID const& argument);
+
+		/**
+		 * Passes the current model to the model sink unless the models are only counted and increments the model counter
+		 * @return true if the required number of models have been found
+		 */
+		bool printModel();
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <chrono>
+#include <optional>
+
+#include "./datamodel/Misc.hpp"
+#include "./datamodel/Instance.hpp"
+#include "./tools/BigUnsigned.hpp"
+
+using namespace std;
+
+/**
+ * Counts the stable extensions of an instance without enumerating them, in the style of #SAT solvers with component caching.
+ * Every argument a is constrained by a <=> no attack on a has all its supporting arguments in. After every decision and propagation, the residual framework is split
+ * into independent components, the count of every component is computed once and multiplied, and the counts are cached by a canonical signature of the component.
+ */
+class ModelCounter
+{
+	private:
+		/**
+		 * Hashes the component signatures
+		 */
+		struct SignatureHash
+		{
+			size_t operator()(vector<ID> const& signature) const;
+		};
+
+		/**
+		 * A component that is currently counted. The search is iterative, thus this is one frame of the explicit stack
+		 */
+		struct Frame
+		{
+			/**
+			 * The unassigned arguments of the component
+			 */
+			vector<ID> arguments;
+
+			/**
+			 * The signature of the component, used as key for the cache
+			 */
+			vector<ID> signature;
+
+			/**
+			 * The argument that is guessed
+			 */
+			ID branchArgument = 0;
+
+			/**
+			 * The number of branches that have been started, i.e. 0 before the guess in, 1 before the guess out and 2 if both have been started
+			 */
+			unsigned char startedBranches = 0;
+
+			/**
+			 * True while the current branch has not been added to the total
+			 */
+			bool isBranchActive = false;
+
+			/**
+			 * The size of the trail before the guess
+			 */
+			size_t trailPosition = 0;
+
+			/**
+			 * The sum of the counts of the finished branches
+			 */
+			BigUnsigned total;
+
+			/**
+			 * The product of the counts of the finished subcomponents of the current branch
+			 */
+			BigUnsigned product;
+
+			/**
+			 * The components the current branch splits into
+			 */
+			vector<vector<ID>> subcomponents;
+
+			/**
+			 * The index of the next subcomponent to count
+			 */
+			size_t nextSubcomponent = 0;
+		};
+
+		/**
+		 * The instance to count the extensions of
+		 */
+		Instance& instance;
+
+		/**
+		 * The maximum number of bytes the cache may use approximately
+		 */
+		size_t cacheLimit;
+
+		/**
+		 * For each attack, the index of its first supporting argument in supportMembers. Contains one additional element marking the end of the last attack
+		 */
+		vector<size_t> supportOffsets;
+
+		/**
+		 * The supporting arguments of all attacks. A self attack contains the attacked argument in its support
+		 */
+		vector<ID> supportMembers;
+
+		/**
+		 * For each attack, the attacked argument
+		 */
+		vector<ID> attackTarget;
+
+		/**
+		 * For each argument, the attacks on it
+		 */
+		vector<vector<ID>> attacksOn;
+
+		/**
+		 * For each argument, the attacks it is a supporting argument of
+		 */
+		vector<vector<ID>> supportedAttacks;
+
+		/**
+		 * The value of each argument, 0 if unassigned, 1 if in and -1 if out
+		 */
+		vector<Sign> values;
+
+		/**
+		 * For each attack, the number of supporting arguments that are out. The attack is blocked iff this is not 0
+		 */
+		vector<ID> outMembers;
+
+		/**
+		 * For each attack, the number of supporting arguments that are unassigned
+		 */
+		vector<ID> unassignedMembers;
+
+		/**
+		 * For each argument, the number of attacks on it that are not blocked
+		 */
+		vector<ID> liveAttacks;
+
+		/**
+		 * The assigned arguments in the order of assignment
+		 */
+		vector<ID> trail;
+
+		/**
+		 * The index in the trail of the next assignment whose consequences are to be propagated
+		 */
+		size_t propagationPosition = 0;
+
+		/**
+		 * Marks the visited arguments and constraints during the computation of components. An entry is visited iff it equals visitStamp
+		 */
+		vector<unsigned long> argumentVisited, constraintVisited;
+
+		/**
+		 * The current visit stamp
+		 */
+		unsigned long visitStamp = 0;
+
+		/**
+		 * The cached counts of components by their signatures
+		 */
+		unordered_map<vector<ID>, BigUnsigned, SignatureHash> cache;
+
+		/**
+		 * The cached signatures in insertion order, used to evict the oldest entries
+		 */
+		deque<vector<ID>> cacheOrder;
+
+		/**
+		 * The approximate number of bytes used by the cache
+		 */
+		size_t cacheSize = 0;
+
+
+	public:
+		/**
+		 * Creates a new counter for the given instance
+		 * @param cacheLimit The maximum number of bytes the component cache may use approximately
+		 */
+		ModelCounter(Instance& instance, size_t const& cacheLimit);
+
+		/**
+		 * Counts the stable extensions of the instance, respecting the required arguments
+		 */
+		BigUnsigned count();
+
+	private:
+		/**
+		 * Assigns the given value to the given argument unless it already has a value
+		 * @return false if the argument has already been assigned the opposite value
+		 */
+		bool assign(ID const& argument, Sign const& value);
+
+		/**
+		 * Propagates the consequences of all assignments on the trail that have not been propagated yet
+		 * @return false if a conflict occurred
+		 */
+		bool propagate();
+
+		/**
+		 * Undoes all assignments after the given trail position
+		 */
+		void undo(size_t const& trailPosition);
+
+		/**
+		 * {@return True iff the constraint of the given argument still restricts unassigned arguments}
+		 */
+		bool isConstraintOpen(ID const& argument) const;
+
+		/**
+		 * Splits the unassigned arguments among the given ones into independent components
+		 */
+		vector<vector<ID>> computeComponents(vector<ID> const& arguments);
+
+		/**
+		 * Computes the canonical signature of a component, which determines its residual framework and thus its count
+		 */
+		vector<ID> computeSignature(vector<ID> const& arguments);
+
+		/**
+		 * Fills the given frame for a component. Returns false and sets result instead if the count is already cached
+		 */
+		bool initializeFrame(Frame& frame, vector<ID>&& arguments, BigUnsigned& result);
+
+		/**
+		 * Counts the extensions of a component under the current assignment
+		 */
+		BigUnsigned countComponent(vector<ID>&& arguments);
+
+		/**
+		 * Adds a count to the cache and evicts the oldest entries if the cache exceeds its limit
+		 */
+		void addToCache(vector<ID>&& signature, BigUnsigned const& count);
+};
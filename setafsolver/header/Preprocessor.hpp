@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "./datamodel/Misc.hpp"
+#include "./datamodel/Instance.hpp"
+
+using namespace std;
+
+/**
+ * Simplifies an instance before the search with reductions that preserve its stable extensions, and maps the extensions of the reduced instance back.
+ * The reductions are:
+ * - The grounded extension is in every stable extension and the arguments it defeats are in none. Both are removed, together with the attacks on them and the attacks
+ *   that contain a defeated argument. Arguments of the grounded extension are removed from the remaining supports
+ * - Arguments whose attacks have identical supports, not containing the argument itself, are in the same stable extensions. They are merged into one representative
+ * - Attacks that became identical to or a superset of another attack on the same argument by the reductions above are collapsed
+ * The grounded reduction runs once, merging and collapsing repeat until nothing changes
+ */
+class Preprocessor
+{
+	private:
+		/**
+		 * An attack given by the attacked argument and its supporting arguments. The support of a self attack contains the attacked argument
+		 */
+		using Attack = pair<ID, vector<ID>>;
+
+		/**
+		 * The instance to reduce
+		 */
+		Instance& instance;
+
+		/**
+		 * For each argument of the instance, 1 if it is in the grounded extension, -1 if it is defeated by it and 0 otherwise
+		 */
+		vector<Sign> groundedValues;
+
+		/**
+		 * For each argument of the instance, the argument it has been merged into or itself. Representatives may be merged again in later rounds
+		 */
+		vector<ID> representatives;
+
+		/**
+		 * For each argument of the reduced instance, the arguments of the instance it represents, in order of their ids
+		 */
+		vector<vector<ID>> represented;
+
+		/**
+		 * The arguments of the grounded extension
+		 */
+		vector<ID> groundedArguments;
+
+		/**
+		 * Indicates whether the required arguments contradict the reductions, thus the instance has no extension
+		 */
+		bool hasConflict = false;
+
+		/**
+		 * The number of arguments that have been merged into others
+		 */
+		size_t numberOfMergedArguments = 0;
+
+		/**
+		 * The number of attacks that have been collapsed
+		 */
+		size_t numberOfCollapsedAttacks = 0;
+
+	public:
+		/**
+		 * Creates a new preprocessor for the given instance, which is not modified
+		 */
+		Preprocessor(Instance& instance);
+
+		/**
+		 * {@return the reduced instance, including the required arguments}
+		 */
+		Instance reduce();
+
+		/**
+		 * {@return true iff the required arguments contradict the reductions, thus the instance has no extension. In that case, the reduced instance must not be solved}
+		 */
+		bool isInconsistent() const;
+
+		/**
+		 * Prints how much the instance has been reduced
+		 */
+		void printReport(Instance& reducedInstance) const;
+
+		/**
+		 * Maps a model of the reduced instance to the model of the instance
+		 * @param inArguments The ids of the arguments of the reduced instance that are in
+		 * @param originalArguments Set to the ascending ids of the arguments of the instance that are in
+		 */
+		void reconstructModel(vector<ID> const& inArguments, vector<ID>& originalArguments) const;
+
+	private:
+		/**
+		 * Computes the grounded extension and the arguments it defeats
+		 */
+		void computeGrounded(vector<Attack> const& attacks);
+
+		/**
+		 * Merges the arguments whose attacks have identical supports and replaces them in all supports by their representative
+		 * {@return true iff any argument has been merged}
+		 */
+		bool mergeArguments(vector<Attack>& attacks);
+
+		/**
+		 * Removes the attacks that are identical to or a superset of another attack on the same argument. The supports must be sorted
+		 */
+		void collapseAttacks(vector<Attack>& attacks);
+
+		/**
+		 * {@return the argument that the given argument has finally been merged into or itself}
+		 */
+		ID findRepresentative(ID argument) const;
+};
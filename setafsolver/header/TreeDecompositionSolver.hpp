@@ -0,0 +1,310 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <optional>
+#include <cstdint>
+
+#include "./datamodel/Misc.hpp"
+#include "./datamodel/Instance.hpp"
+#include "./tools/ModelSink.hpp"
+#include "./tools/BigUnsigned.hpp"
+#include "./tools/TreeDecomposition.hpp"
+
+using namespace std;
+
+class Preprocessor;
+
+/**
+ * Counts and enumerates the stable extensions by dynamic programming over a tree decomposition of the primal graph.
+ * The state of a bag assigns every argument in it to in, out or out and defeated, where defeated means that an attack on it with all its supporting arguments in
+ * has been seen below. The states are packed into two bitsets, one marking the arguments that are in and one marking the defeated ones.
+ * Every attack is handled in the bag of its argument that is eliminated first, which contains all arguments of the attack. When the argument of a bag is forgotten,
+ * it has to be in or defeated. If the tables would exceed the memory limit, the computation is abandoned before any model has been passed
+ */
+class TreeDecompositionSolver
+{
+	public:
+		/**
+		 * The largest supported width, as the states of a bag are packed into 32 bit masks
+		 */
+		static constexpr size_t maximumWidth = 31;
+
+	private:
+		/**
+		 * The states of a table with their number of partial extensions, which is never 0. The states are grouped by the mask of the arguments in, which indexes
+		 * the groups directly, and sorted by the mask of the defeated arguments within a group
+		 */
+		struct Table
+		{
+			/**
+			 * For each mask of arguments in, the index of its first state. Contains one additional element marking the end of the last group
+			 */
+			vector<uint32_t> offsets;
+
+			/**
+			 * For each state, the mask of the defeated arguments
+			 */
+			vector<uint32_t> defeated;
+
+			/**
+			 * For each state, the number of partial extensions in it
+			 */
+			vector<BigUnsigned> counts;
+
+			/**
+			 * {@return the index of the given state or none if the table does not contain it}
+			 */
+			optional<size_t> find(uint32_t const& in, uint32_t const& defeatedMask) const;
+
+			/**
+			 * {@return the approximate number of bytes used by the table}
+			 */
+			size_t getMemory() const;
+		};
+
+		/**
+		 * The approximate number of bytes of a state in a table or in the states collected for a table, including the allocation of the limbs of its count
+		 */
+		static constexpr size_t stateMemory = sizeof(pair<uint64_t, BigUnsigned>) + 32;
+
+		/**
+		 * A part of the decomposition that has to be enumerated in a given state. Either the message of a bag, or the table of a bag after joining its first level children
+		 */
+		struct Task
+		{
+			/**
+			 * The index of the bag
+			 */
+			size_t bag;
+
+			/**
+			 * The number of joined children or messageLevel
+			 */
+			size_t level;
+
+			/**
+			 * The state to enumerate
+			 */
+			uint32_t in, defeated;
+		};
+
+		/**
+		 * A way to enumerate a task
+		 */
+		struct Alternative
+		{
+			/**
+			 * The argument that is assigned by the alternative or none
+			 */
+			optional<pair<ID, Sign>> assignment;
+
+			/**
+			 * The tasks that remain
+			 */
+			vector<Task> tasks;
+		};
+
+		/**
+		 * A task with more than one alternative
+		 */
+		struct ChoicePoint
+		{
+			/**
+			 * The size of the log when the task was taken
+			 */
+			size_t logPosition;
+
+			/**
+			 * The alternatives of the task
+			 */
+			vector<Alternative> alternatives;
+
+			/**
+			 * The index of the next alternative to try
+			 */
+			size_t next;
+		};
+
+		/**
+		 * Marks a task that enumerates the message of a bag
+		 */
+		static constexpr size_t messageLevel = numeric_limits<size_t>::max();
+
+		/**
+		 * The instance to solve
+		 */
+		Instance& instance;
+
+		/**
+		 * The decomposition of the instance
+		 */
+		TreeDecomposition const& decomposition;
+
+		/**
+		 * The time at which time first model has been found
+		 */
+		chrono::time_point<chrono::high_resolution_clock>& firstModelTime;
+
+		/**
+		 * The number of models found, saturated at the largest unsigned long
+		 */
+		unsigned long& modelCount;
+
+		/**
+		 * Will be set to the exact number of models if they are only counted
+		 */
+		optional<BigUnsigned>& exactModelCount;
+
+		/**
+		 * The percentage of the search space that has been checked
+		 */
+		double& percentageSolved;
+
+		/**
+		 * The number of models to find or 0 for unlimited
+		 */
+		unsigned long& numberOfModels;
+
+		/**
+		 * Receives the found models
+		 */
+		ModelSink& modelSink;
+
+		/**
+		 * Indicates whether the models are passed to the model sink, otherwise they are only counted
+		 */
+		bool printModels;
+
+		/**
+		 * For each bag, the attacks handled in it as mask of the supporting arguments and position of the attacked argument
+		 */
+		vector<vector<pair<uint32_t, unsigned char>>> localAttacks;
+
+		/**
+		 * For each bag, the positions of the arguments of its message, i.e. all arguments except the first, in the bag of its parent
+		 */
+		vector<vector<unsigned char>> positionsInParent;
+
+		/**
+		 * For each argument, the value it is required to have or 0
+		 */
+		vector<Sign> requiredValues;
+
+		/**
+		 * Indicates whether an argument is required to be in and out at once
+		 */
+		bool hasConflictingRequirements = false;
+
+		/**
+		 * The number of bytes the tables may use
+		 */
+		size_t memoryLimit;
+
+		/**
+		 * The approximate number of bytes used by the tables that are kept
+		 */
+		size_t tableMemory = 0;
+
+		/**
+		 * For each bag, its message, i.e. its table after forgetting its argument
+		 */
+		vector<Table> messages;
+
+		/**
+		 * For each bag, the table after every joined child. Only kept if the models are enumerated
+		 */
+		vector<vector<Table>> levels;
+
+		/**
+		 * The value of each argument in the model that is currently enumerated
+		 */
+		vector<Sign> values;
+
+		/**
+		 * If not null, the instance has been reduced and the models are passed as models of the original instance
+		 */
+		Preprocessor const* reconstruction = nullptr;
+
+		/**
+		 * The ids of the arguments that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> modelArguments;
+
+		/**
+		 * The ids of the arguments of the original instance that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> originalModelArguments;
+
+	public:
+		/**
+		 * Creates a solver whose tables use at most the given number of bytes
+		 */
+		TreeDecompositionSolver(Instance& instance, TreeDecomposition const& decomposition, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, optional<BigUnsigned>& exactModelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, size_t const& memoryLimit);
+
+		/**
+		 * Counts the extensions and enumerates them if they are printed
+		 * @return false if the tables would exceed the memory limit, then no model has been passed and the instance has to be solved otherwise
+		 */
+		bool solve();
+
+		/**
+		 * Passes the models as models of the original instance of the given preprocessor
+		 */
+		void setReconstruction(Preprocessor const* reconstruction);
+
+	private:
+		/**
+		 * Assigns every attack to the bag of its argument that is eliminated first and maps the messages into the bags of their parents
+		 */
+		void initialize();
+
+		/**
+		 * Computes the tables and the message of the given bag from the messages of its children
+		 * @return false if the tables would exceed the memory limit
+		 */
+		bool computeTables(size_t const& bag);
+
+		/**
+		 * {@return True iff the given number of collected states fits into the memory limit next to the kept tables. The collected states and the table built from them
+		 * exist at once, thus they are counted twice}
+		 */
+		bool fitsMemory(size_t const& numberOfStates) const;
+
+		/**
+		 * Builds a table whose masks of arguments in have the given number of bits from the given packed states, summing the counts of equal states. Clears the states
+		 * @return false if the index of the groups would exceed the memory limit
+		 */
+		bool buildTable(vector<pair<uint64_t, BigUnsigned>>& states, size_t const& numberOfBits, Table& table);
+
+		/**
+		 * Enumerates the extensions
+		 */
+		void enumerate(BigUnsigned const& count);
+
+		/**
+		 * {@return the alternatives of the given task}
+		 */
+		vector<Alternative> computeAlternatives(Task const& task) const;
+
+		/**
+		 * Passes the current model to the model sink and increments the model counter
+		 */
+		void printModel();
+
+		/**
+		 * {@return the packed state, which orders the states by the arguments in first}
+		 */
+		static uint64_t pack(uint32_t const& in, uint32_t const& defeated);
+
+		/**
+		 * {@return the bits of a bag mask at the given positions, as a mask of the message of a child}
+		 */
+		static uint32_t gather(uint32_t const& mask, vector<unsigned char> const& positions);
+
+		/**
+		 * {@return the mask of a message of a child at the given positions of a bag}
+		 */
+		static uint32_t scatter(uint32_t const& mask, vector<unsigned char> const& positions);
+};
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <limits>
+#include <tuple>
 
 #include "Misc.hpp"
 
@@ -27,6 +28,9 @@ class Argument
 		///The name of the argument. Either the number or the name
 		string name;
 
+		///The number of the argument in the input file, which is kept by sub instances. Identifies the argument in binary proofs
+		ID number;
+
 		///The decision level that which this argument has been assigned a value
 		DL dl = std::numeric_limits<ID>::max();
 
@@ -51,8 +55,15 @@ class Argument
 		///The index of the attack in attackedBy that is used as witness for the stability of this argument if its value set to -1
 		size_t watchedInAttackIndex = 0;
 
-		///A list of all arguments that use this argument as witness for stability. The second pair element is the index of the attack for which this argument is one of the witnesses
-		vector<pair<Argument*, size_t>> stabilityWatch;
+		///A list of all arguments that use this argument as witness for stability. The second element is the index of the attack for which this argument is one of the witnesses, the third the index of this argument in the members of that attack.
+		///Every attack is contained at most once, entries for attacks that are no longer the witness are dropped when this argument is set out
+		vector<tuple<Argument*, size_t, size_t>> stabilityWatch;
+
+		///The number of entries in the stability watches of all arguments
+		inline static size_t stabilityWatchEntryCount = 0;
+
+		///The largest number of entries in the stability watches of all arguments at any time
+		inline static size_t stabilityWatchPeakEntryCount = 0;
 
 	public: 		
 
@@ -84,7 +95,17 @@ class Argument
 		/**
 		 * Gets the name of the argument, either the number as string or the name if supplied
 		 */
-		string getName() const;
+		string const& getName() const;
+
+		/**
+		 * Sets the number of the argument in the input file
+		 */
+		void setNumber(ID const& number);
+
+		/**
+		 * {@return the number of the argument in the input file}
+		 */
+		ID getNumber() const;
 
 		/**
 		 * Sets the id and position of this argument
@@ -198,12 +219,23 @@ class Argument
 		/**
 		 * Removes the last element of the stability watch
 		 */
-		pair<Argument&, size_t> stabilityWatchPop();
+		tuple<Argument&, size_t, size_t> stabilityWatchPop();
+
+		/**
+		 * Add the given argument and index to the stability watch of this argument, unless the attack is already contained
+		 * @param position The index of this argument in the members of the attack
+		 */
+		void stabilityWatchPush(Argument& argument, size_t const& index, size_t const& position);
+
+		/**
+		 * Removes all elements of the stability watch
+		 */
+		void clearStabilityWatch();
 
 		/**
-		 * Add the given argument and index to the stability watch of this argument
+		 * {@return the largest number of bytes used by the stability watches of all arguments at any time}
 		 */
-		void stabilityWatchPush(Argument& argument, size_t const& index);
+		static size_t getStabilityWatchPeakMemory();
 
 		/**
 		 * Return the reason this argument has been assigned the assigned value
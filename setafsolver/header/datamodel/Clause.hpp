@@ -24,6 +24,10 @@ class Clause
 		 * The ID of the clause
 		 */
 		ID id = 0;
+		/**
+		 * The id of the clause in a proof with hints. For attacks the number of the attack in the instance file, for derived clauses the id of the line that added it to the proof, 0 if it has not been written
+		 */
+		ID proofId = 0;
 		/**
 		 * The index in the members vector of the argument that is the first watched argument
 		 */
@@ -48,6 +52,10 @@ class Clause
 		 * The index in the instance's forgotten clauses vector. Only relevant for forgotten clauses
 		 */
 		size_t indexInForgottenClausesVector = 0;
+		/**
+		 * For each member, whether the attack is in the stability watch of that member. Only relevant for attacks, allocated on first use
+		 */
+		vector<bool> stabilityWatchedMembers;
 
 	public:
 
@@ -86,6 +94,16 @@ class Clause
 		 */
 		ID getId() const;
 
+		/**
+		 * Sets the id of the clause in a proof with hints
+		 */
+		void setProofId(ID const& proofId);
+
+		/**
+		 * {@return the id of the clause in a proof with hints or 0 if it has not been written}
+		 */
+		ID getProofId() const;
+
 		/**
 		 * Sets the attacked argument of the clause and adds it to the attackers of the argument. Updates the watches if appropriate
 		 * Only relevant for the original attacks of the instance, not for learned clauses
@@ -102,6 +120,11 @@ class Clause
 		 */
 		void addArgument(Argument& argument, Sign const& sign);
 
+		/**
+		 * Adds an argument to the members of this clause without watching it. Only for clauses that are read, but never propagated
+		 */
+		void addUnwatchedArgument(Argument& argument, Sign const& sign);
+
 		/**
 		 * {@return Returns a pair of the start and end iterators over the members of this clause}
 		 */
@@ -204,6 +227,16 @@ class Clause
 		 */
 		bool setWatch(bool const& isFirst, size_t const& index);
 
+		/**
+		 * {@return True iff the attack is in the stability watch of the member at the given index}
+		 */
+		bool isStabilityWatchedBy(size_t const& index) const;
+
+		/**
+		 * Sets whether the attack is in the stability watch of the member at the given index
+		 */
+		void setStabilityWatchedBy(size_t const& index, bool const& isWatched);
+
 		/**
 		 * Checks if the watched are valid, assuming that at least one argument does not have value 0
 		 */
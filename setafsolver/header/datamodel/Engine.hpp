@@ -0,0 +1,48 @@
+#pragma once
+#include <optional>
+
+using namespace std;
+
+/**
+ * Represents the engine used to solve an instance
+ */
+class Engine
+{
+	public:
+		/**
+		 * The engines supported by the solver
+		 */
+		enum class EngineType { Auto, Enumeration, Counting, TreeDecomposition, FixedArity };
+
+		/**
+		 * @{return A object of Engine that represents the provided string or none if the string could not be parsed}
+		 */
+		static optional<Engine> tryParse(char* const& s);
+
+	private:
+		/**
+		 * The type of engine to be used
+		 */
+		EngineType type;
+
+	public:
+		/**
+		 * Create a new instance of Engine with the provided type
+		 */
+		Engine(EngineType const& type);
+
+		/**
+		 * Create a new instance of Engine with the type Auto
+		 */
+		Engine();
+
+		Engine(const Engine& other) = default;
+		Engine(Engine&& other) = default;
+		Engine& operator=(const Engine& other) = default;
+		Engine& operator=(Engine&& other) = default;
+
+		/**
+		 * Returns the type of the engine
+		 */
+		EngineType const& getType() const;
+};
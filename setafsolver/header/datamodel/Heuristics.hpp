@@ -17,13 +17,23 @@ class Heuristics
 		/**
 		 * The heuristics supported by the solver
 		 */
-		enum class HeuristicTypes {None, MaxOutDegree, MinInDegree, PathLength, PathLengthModified };		
+		enum class HeuristicTypes {None, MaxOutDegree, MinInDegree, PathLength, PathLengthModified, PageRank, EigenvectorCentrality };		
 
 		/**
 		* @{return A object of Heuristics that represents the provided string or none if the string could not be parsed}
 		*/
 		static optional<Heuristics> tryParse(char const* const s);
 
+		/**
+		 * The number of iterations after which the centrality heuristics stop if no iteration cap is provided
+		 */
+		static constexpr unsigned short defaultMaximumIterations = 100;
+
+		/**
+		 * The L1 distance between two iterations below which the centrality heuristics stop if no tolerance is provided
+		 */
+		static constexpr double defaultTolerance = 1e-6;
+
 	private:
 		/**
 		 * The type of heuristics to be used
@@ -35,6 +45,11 @@ class Heuristics
 		 */
 		variant<unsigned short> heuristicsParameter1;			
 
+		/**
+		 * The second heuristics parameter
+		 */
+		variant<double> heuristicsParameter2;
+
 	public:
 
 		/**
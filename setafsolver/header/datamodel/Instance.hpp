@@ -4,7 +4,6 @@
 #include <deque>
 #include <cassert>
 #include <memory>
-#include <fstream>
 
 #include "Misc.hpp"
 #include "Argument.hpp"
@@ -13,6 +12,8 @@
 
 using namespace std;
 
+class ProofWriter;
+
 /**
  * Represents a SETAF instance
  */
@@ -62,27 +63,19 @@ class Instance
 		ID nextClauseID;		
 
 		/**
-		 * {@return a new clause, either recycle a used clause that has been forgotten one or a new one with a given initial capacity}
+		 * The number of attacks in the instance file, including the subsumed attacks that the parser removed. The clauses derived in a proof with hints are numbered after them
 		 */
-		Clause& getNewClause(size_t const& capacity, Clause::ClauseType const& clauseType);
+		ID numberOfInputAttacks;
 
 		/**
-		 * Write the clause to the proof file.
-		 */		
-		void writeProofClause(Clause* clause, std::unique_ptr<ofstream>& proofFile)
-		{
-			*proofFile << "d "; 
-
-			for (auto [beginMember, endMember] = clause->getMembersIterator(); beginMember != endMember; beginMember++)
-			{
-				auto& [argument, sign] = *beginMember;
-				if (sign == -1)
-					*proofFile << "-";
-				*proofFile << argument->getName();
-				*proofFile << " ";
-			}
-			*proofFile << "0\n";
-		}
+		 * The proof to which forgotten clauses are written as deleted once they are recycled, as they might still be the reason of an assignment until then. Null if no proof is generated
+		 */
+		ProofWriter* deletionProof = nullptr;
+
+		/**
+		 * {@return a new clause, either recycle a used clause that has been forgotten one or a new one with a given initial capacity}
+		 */
+		Clause& getNewClause(size_t const& capacity, Clause::ClauseType const& clauseType);
 
 	public:
 		
@@ -96,6 +89,14 @@ class Instance
 		Instance& operator=(const Instance& other) = default;
 		Instance& operator=(Instance&& other) = default;
 		
+		/**
+		 * {@return a new instance that consists of the given arguments and attacks of this instance. Names and the self attack flags are retained}
+		 * @param argumentIds The ids of the arguments in this instance. The argument argumentIds[i] gets the id i in the new instance
+		 * @param attackIds The ids of the attacks in this instance. Every member of these attacks must be contained in argumentIds
+		 * @param localIds For each argument in this instance by id, its index in argumentIds. Only the entries of the given arguments are read
+		 */
+		Instance getSubInstance(vector<ID> const& argumentIds, vector<ID> const& attackIds, vector<ID> const& localIds);
+
 		/**
 		 * {@return the attack with the given id}
 		 */
@@ -145,6 +146,21 @@ class Instance
 		 * {@return the number of attacks}
 		 */
 		size_t getNumberOfAttacks() const;
+
+		/**
+		 * Sets the number of attacks in the instance file, including the subsumed attacks that have been removed
+		 */
+		void setNumberOfInputAttacks(ID const& numberOfInputAttacks);
+
+		/**
+		 * {@return the number of attacks in the instance file, including the subsumed attacks that have been removed}
+		 */
+		ID getNumberOfInputAttacks() const;
+
+		/**
+		 * {@return the largest number of supporting arguments of an attack, where the attacked argument of a self attack is one of them}
+		 */
+		size_t getMaximumSupportSize() const;
 		
 		/**
 		 * {@return a new clause flagged as output clause, either recycle a used clause that has been forgotten one or a new one with a given initial capacity}
@@ -157,6 +173,11 @@ class Instance
 		 */
 		Clause& getNewLearnedClause(const size_t& capacity);
 
+		/**
+		 * {@return a new clause flagged as learned clause that is never forgotten, either recycle a used clause that has been forgotten one or a new one with a given initial capacity}
+		 */
+		Clause& getNewPermanentClause(const size_t& capacity);
+
 		/**
 		 * Removes the given clause from the list of forgot clauses and adds it to the list of available clauses, if the clause is marked as forgotten
 		 */
@@ -168,7 +189,7 @@ class Instance
 		size_t getNumberOfLearnedClauses() const;
 
 		/**
-		 * Marks the given number of clauses as forgotten
+		 * Marks the given number of clauses as forgotten. If a proof is generated, the clauses are written to it as deleted once they are no longer used
 		 */		
-		void forgetClauses(size_t amountOfClausesToForget, std::unique_ptr<ofstream>& proofFile, bool generateProof);
+		void forgetClauses(size_t amountOfClausesToForget, std::unique_ptr<ProofWriter>& proofFile, bool generateProof);
 };
\ No newline at end of file
@@ -3,6 +3,9 @@
 //For debugging proposes
 //#define TRACE
 
+//Counts the search statistics of the solver, remove to compile the search without the counters
+#define STATISTICS
+
 /**
  * Represents the sign of an argument, either assigned to it or as occurring in a clause
  */
@@ -11,9 +11,57 @@
 #include "./datamodel/Clause.hpp"
 #include "../header/datamodel/Heuristics.hpp"
 #include "../header/datamodel/Semantics.hpp"
+#include "./tools/ProofWriter.hpp"
+#include "./tools/ModelSink.hpp"
+#include "./tools/SearchStatistics.hpp"
 
 using namespace std;
 
+class Preprocessor;
+
+/**
+ * The options of the solver that are fixed at compile time, such that the search has no branches for the disabled ones. Tracing is fixed by TRACE in Misc.hpp
+ */
+template <bool WritesProof, bool UsesStabilityCounters>
+struct SolverPolicy
+{
+	/**
+	 * Indicates whether the proof is written
+	 */
+	static constexpr bool writesProof = WritesProof;
+
+	/**
+	 * Indicates whether stability is propagated by counters of the unblocked attacks instead of the stability watches
+	 */
+	static constexpr bool usesStabilityCounters = UsesStabilityCounters;
+};
+
+/**
+ * Calls the given function with the policy of the given options, e.g. to create a solver for them
+ */
+template <typename Function>
+void dispatchSolverPolicy(bool const& writesProof, bool const& usesStabilityCounters, Function&& function)
+{
+	if (writesProof)
+	{
+		if (usesStabilityCounters)
+			function(SolverPolicy<true, true>());
+		else
+			function(SolverPolicy<true, false>());
+	}
+	else
+	{
+		if (usesStabilityCounters)
+			function(SolverPolicy<false, true>());
+		else
+			function(SolverPolicy<false, false>());
+	}
+}
+
+/**
+ * Enumerates the stable extensions by a search with clause learning. The options given by the policy are fixed at compile time
+ */
+template <typename Policy>
 class Solver
 {
 	private:
@@ -53,9 +101,19 @@ class Solver
 		unsigned long& numberOfModels;
 
 		/**
-		 * Indicates whether models should be printed to stdout
+		 * Receives the found models
+		 */
+		ModelSink& modelSink;
+
+		/**
+		 * Indicates whether the models are passed to the model sink, otherwise they are only counted
 		 */
-		bool const& printModels;
+		bool printModels;
+
+		/**
+		 * Indicates whether the strongly connected components should be guessed one after another in topological order
+		 */
+		bool const& sccRecursive;
 
 		/**
 		 * The number of learned clauses that, when reached, causes a new forget cycle
@@ -87,6 +145,11 @@ class Solver
 		 */
 		ID nextGuessPosition = 0;
 
+		/**
+		 * The arguments that are not guessed, as their value is determined by the guessed ones, in the order they are assigned once all guessed arguments are assigned
+		 */
+		vector<Argument*> deferredArguments;
+
 		/**
 		 * Holds the assigned arguments
 		 */
@@ -103,15 +166,153 @@ class Solver
 		vector<pair<Argument*, Sign> const*> helperVectorArgumentSign;		
 
 		/**
-		 * The file to which the proof is written to.
+		 * The file to which the proof is written to. Only used if the policy writes the proof
+		 */
+		std::unique_ptr<ProofWriter>& proofFile;
+
+		/**
+		 * The implicit clause of the last stability conflict. It is not watched and not part of the learned clauses, its literals are only selected when they are needed
 		 */
-		std::unique_ptr<ofstream>& proofFile;
+		Clause implicitClause;
+
+		/**
+		 * The argument whose stability is violated by the implicit clause
+		 */
+		Argument* implicitClauseArgument = nullptr;
+
+		/**
+		 * Indicates whether the literals of the implicit clause have been selected
+		 */
+		bool implicitClauseHasLiterals = false;
+
+		/**
+		 * Indicates whether the implicit clause has been resolved into a learned clause, after which the proof does not reference it anymore
+		 */
+		bool isImplicitClauseResolved = false;
+
+		/**
+		 * For each argument, whether it has been resolved in the current conflict analysis. Only allocated if the proof has hints
+		 */
+		vector<bool> isResolved;
+
+		/**
+		 * The proof ids of the clauses a learned clause has been derived from. Member to avoid reallocation
+		 */
+		vector<ID> proofHints;
+
+		/**
+		 * If not null, the instance has been reduced and the models are passed as models of the original instance
+		 */
+		Preprocessor const* reconstruction = nullptr;
+
+		/**
+		 * The ids of the arguments that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> modelArguments;
+
+		/**
+		 * The ids of the arguments of the original instance that are in the current model. Member to avoid reallocation
+		 */
+		vector<ID> originalModelArguments;
+
+		/**
+		 * The number of assignments that failed literal probing may do at dl 0 or 0 to disable it
+		 */
+		unsigned long probingBudget = 0;
+
+		/**
+		 * Indicates whether equivalent arguments should be detected before the search
+		 */
+		bool detectEquivalences = false;
+
+		/**
+		 * For each attack, the id of its support. Identical supports of different attacks share one id. Not set for self attacks, which are always blocked
+		 */
+		vector<ID> attackSupports;
+
+		/**
+		 * For each support, the number of its arguments that are out. Every attack with this support is blocked iff this is not 0
+		 */
+		vector<ID> outSupportCounts;
+
+		/**
+		 * For each support, the index of its first attacked argument in supportTargets. Contains one additional element marking the end of the last support
+		 */
+		vector<size_t> supportTargetOffsets;
+
+		/**
+		 * The arguments attacked by every support
+		 */
+		vector<ID> supportTargets;
+
+		/**
+		 * For each argument, the index of its first support in supportsContaining. Contains one additional element marking the end of the last argument
+		 */
+		vector<size_t> supportsContainingOffsets;
+
+		/**
+		 * The supports every argument is contained in
+		 */
+		vector<ID> supportsContaining;
+
+		/**
+		 * For each argument, the number of attacks on it that are not blocked, where self attacks are always blocked. Only maintained if the policy uses stability counters
+		 */
+		vector<ID> unblockedAttackCounts;
+
+		/**
+		 * The supports blocked by the assignments that are being propagated, every assignment pushes those it blocked and removes them once it has propagated stability.
+		 * Only maintained if the policy uses stability counters
+		 */
+		vector<ID> blockedSupports;
+
+		/**
+		 * For each argument, the clause that implies it to be in as supporting argument of the only unblocked attack on an out argument. Like the implicit clause, its
+		 * literals are only selected when they are needed. Only allocated if the policy uses stability counters
+		 */
+		vector<Clause> stabilityReasons;
+
+		/**
+		 * For each argument implied by its stability reason, the out argument whose only unblocked attack it supports
+		 */
+		vector<Argument*> stabilityReasonArguments;
+
+		/**
+		 * For each argument, whether the literals of its stability reason have been selected
+		 */
+		vector<bool> stabilityReasonHasLiterals;
+
+		/**
+		 * For each argument, whether it has been selected for the current stability reason. Member to avoid reallocation
+		 */
+		vector<bool> isSelectedForStabilityReason;
+
+		/**
+		 * Indicates whether the arguments are being probed, the deletions of stability reasons are then deferred
+		 */
+		bool isProbing = false;
+
+		/**
+		 * The stability reasons that have been replaced while probing an argument, given by their proof id and literals. They are deleted from the proof once the lemmas
+		 * of the argument, which might depend on them, have been written
+		 */
+		vector<pair<ID, vector<pair<Argument*, Sign>>>> deferredReasonDeletions;
+
+		/**
+		 * For each assigned argument, its index in assingedArguments. Only maintained if the policy uses stability counters
+		 */
+		vector<size_t> assignmentPositions;
+
+		/**
+		 * The counters of the search. Last member, as they are aligned to their own cache lines
+		 */
+		SearchStatistics statistics;
 
 	public:
 		/**
 		 * Create a new solver with the given instance
 		 */
-		Solver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, bool const& printModels, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ofstream>& proofFile);
+		Solver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, bool const& sccRecursive, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ProofWriter>& proofFile);
 		Solver(const Solver& other) = default;
 		Solver(Solver&& other) = default;
 		Solver& operator=(const Solver& other) = default;
@@ -123,10 +324,31 @@ class Solver
 		 */		
 		void solve();	
 
+		/**
+		 * Passes the models as models of the original instance of the given preprocessor
+		 */
+		void setReconstruction(Preprocessor const* reconstruction);
+
+		/**
+		 * Enables failed literal probing at dl 0 with the given number of assignments, 0 disables it
+		 */
+		void setProbingBudget(unsigned long const& probingBudget);
+
+		/**
+		 * Enables the detection of equivalent arguments before the search
+		 */
+		void setDetectEquivalences(bool const& detectEquivalences);
+
+		/**
+		 * {@return the counters of the search}
+		 */
+		SearchStatistics const& getStatistics() const;
+
+
 	private:
 
 		/**
-		 * Prints the current assignment if printModels is true and increments the model counter
+		 * Passes the current assignment to the model sink unless the models are only counted and increments the model counter
 		 *
 		 * @return True if the required number of models have been found
 		 */
@@ -143,16 +365,77 @@ class Solver
 		void writeProofClause(Clause& clause, bool isImplicitClause);
 
 		/**
-		 * Builds the implicit clause that represents the conflict that occurred when assigning the given argument
+		 * Write a clause that is not represented by a clause object to the proof file.
+		 */
+		void writeProofClause(vector<pair<Argument*, Sign>> const& literals, bool isImplicitClause);
+
+		/**
+		 * Writes a learned clause to the proof file. If the proof has hints, they are the reasons of the resolved arguments in the order of their assignment, followed by the
+		 * conflicting clause. Clears the marks of the resolved arguments
+		 */
+		void writeLearnedProofClause(Clause& learnedClause, Clause& conflictingClause, size_t numberOfResolvedArguments);
+
+		/**
+		 * Builds the implicit clause that represents the conflict that occurred when assigning the given argument. The clause is virtual, its literals are only selected once
+		 * the conflict is analysed or the clause is written to the proof, and it only becomes a learned clause if it is asserting itself
 		 */
 		Clause& buildImplictClause(Argument& arg);
 
+		/**
+		 * Selects the literals of the implicit clause, unless already done
+		 */
+		void selectImplicitClauseLiterals();
+
+		/**
+		 * {@return the given clause, or a new learned clause with the same literals if it is the implicit clause}
+		 */
+		Clause& materializeImplicitClause(Clause& clause);
+
 		/**
 		 * Recomputes the watched attack for an argument.
 		 * Every argument assigned -1 needs an attack of the original instance that attacks it. Here, we try to find such a clause and set the stability watches.
 		 */
 		Clause* recomputeWatchedAttack(Argument& arg, size_t* const forAttackIndex);
 
+		/**
+		 * Interns the supports of the attacks and counts their arguments that are out, as well as the unblocked attacks on every argument if the policy uses stability counters
+		 */
+		void initializeStabilityCounters();
+
+		/**
+		 * {@return True iff the given attack is not blocked. Same as Clause::isNotBlocked for the current dl, but answered by the counter of its support}
+		 */
+		bool isNotBlocked(Clause const& attack) const;
+
+		/**
+		 * Updates the counters of the supports containing the given argument after it has been assigned out. The supports it blocked are pushed to blockedSupports
+		 */
+		void blockSupportedAttacks(Argument& argument);
+
+		/**
+		 * Updates the counters of the supports containing the given argument before its assignment to out is undone
+		 */
+		void unblockSupportedAttacks(Argument& argument);
+
+		/**
+		 * Propagates the stability of the given argument, which has been assigned out, and of the out arguments attacked by the supports it blocked, given by the range
+		 * of blockedSupports, which is removed afterwards
+		 * @return the conflicting clause or nullptr
+		 */
+		Clause* propagateStability(Argument& argument, size_t const& blockedSupportsBegin, size_t const& blockedSupportsEnd);
+
+		/**
+		 * Propagates the stability of the given out argument: without unblocked attack it is a conflict, with a single one its supporting arguments are assigned in
+		 * @return the conflicting clause or nullptr
+		 */
+		Clause* enforceStability(Argument& argument);
+
+		/**
+		 * Selects the literals of the stability reason of the given argument, i.e. the out argument, the given argument and, for every other attack on the out argument,
+		 * a supporting argument that is out and has been assigned before the given position
+		 */
+		void selectStabilityReasonLiterals(Argument& argument, size_t const& position);
+
 		/**
 		 * Checks a given clause by updating watches
 		 * @param wasRemoved will be set to true if the clause was removed from an arguments watchedIn vector
@@ -191,6 +474,29 @@ class Solver
 		 */
 		bool computeGrounded();
 
+		/**
+		 * Tentatively sets every unassigned argument in and out. If one value causes a conflict, the other one is asserted at dl 0. The arguments that are assigned the same
+		 * value by both are asserted at dl 0 too. Repeated until nothing changes or the budget is exhausted
+		 * @return false if the instance has no extension
+		 */
+		bool probe();
+
+		/**
+		 * Assigns the given value at dl 1, collects the implied assignments and undoes them
+		 * @return true iff the assignment caused a conflict
+		 */
+		bool probeValue(Argument& argument, Sign const& value, vector<pair<Argument*, Sign>>& implied, unsigned long& budget);
+
+		/**
+		 * Deletes the given stability reason from the proof, unless the arguments are being probed, in which case the deletion is deferred
+		 */
+		void deleteStabilityReason(Clause& reason);
+
+		/**
+		 * Deletes the stability reasons whose deletion has been deferred while probing from the proof
+		 */
+		void writeDeferredReasonDeletions();
+
 		/**
 		 * Does an assignment and handles backtracking
 		 */
@@ -202,6 +508,44 @@ class Solver
 		 */
 		double calculate_stable();
 
+		/**
+		 * Reorders the arguments to guess such that the strongly connected components of the attack graph are guessed one after another in topological order.
+		 * The order within a component is retained. Thus, every component is searched under a fixed assignment of all components attacking it
+		 */
+		void orderByStronglyConnectedComponents(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder);
+
+		/**
+		 * Removes the arguments from the arguments to guess that are contained in no support, and iteratively those only contained in supports of attacks on removed arguments.
+		 * Under stable semantics, the removed arguments are determined by the arguments attacking them and are collected in deferredArguments, such that every argument
+		 * comes after all arguments in the supports of the attacks on it
+		 */
+		void deferSinkArguments(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder);
+
+		/**
+		 * Computes the strongly connected components of the implication graph of the binary clauses at dl 0 over the arguments to guess. The clauses stem from attacks and
+		 * from arguments with a single unblocked attack, which is added as clause. Of every component, only the argument with the lowest id is guessed, the others are
+		 * equivalent or anti-equivalent to it and are assigned by propagation. They are moved to deferredArguments
+		 * @return false if an argument is equivalent to its own negation, thus the instance has no extension
+		 */
+		bool deferEquivalentArguments(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder);
+
+		/**
+		 * Removes the marked arguments from the arguments to guess and updates the positions. Removed arguments get a position that is never guessed
+		 */
+		void removeFromGuessOrder(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder, vector<bool> const& isRemoved);
+
+		/**
+		 * Assigns the deferred arguments that have not been assigned by propagation once all guessed arguments are assigned. Each one is in, as all attacks on it are blocked,
+		 * and is assigned at a new dl
+		 * @return the conflicting clause or nullptr
+		 */
+		Clause* assignDeferredArguments();
+
+		/**
+		 * {@return the dl of the last guessed argument, ignoring the dls of the deferred arguments, or 0 if there is none}
+		 */
+		DL getLastGuessDl() const;
+
 		/**
 		 * Calculates how much of the search space has been exhausted
 		 * @return the percentage of the search space that has been exhausted
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../datamodel/Misc.hpp"
+#include "./ModelSink.hpp"
+
+using namespace std;
+
+/**
+ * Passes the models to another sink on a dedicated thread, such that formatting and writing them does not stall the search. Every model is copied into a preallocated
+ * slot of a bounded ring buffer, which the search thread fills and the writing thread empties without locks. A thread only takes a lock to sleep while the ring
+ * buffer is full or empty. If the ring buffer is full, the search thread either waits for a free slot or drops the model, which is then only counted
+ */
+class AsyncModelSink : public ModelSink
+{
+	public:
+		/**
+		 * The behaviours of the search thread if the ring buffer is full
+		 */
+		enum class Backpressure { Block, Drop };
+
+		/**
+		 * {@return the behaviour represented by the given string or none if it is unknown}
+		 */
+		static optional<Backpressure> tryParseBackpressure(char const* s);
+
+	private:
+		/**
+		 * The number of bytes the arguments of all slots may take, which bounds the number of slots for large instances
+		 */
+		static constexpr size_t slotMemory = 1 << 24;
+
+		/**
+		 * The largest number of slots
+		 */
+		static constexpr size_t maximumSlotCount = 1024;
+
+		/**
+		 * The number of times a thread checks the ring buffer again before it sleeps
+		 */
+		static constexpr unsigned spinCount = 64;
+
+		/**
+		 * The sink the models are passed to by the writing thread
+		 */
+		unique_ptr<ModelSink> sink;
+
+		/**
+		 * The behaviour if the ring buffer is full
+		 */
+		Backpressure backpressure;
+
+		/**
+		 * The number of slots
+		 */
+		size_t slotCount;
+
+		/**
+		 * For each slot, the ids of the arguments of its model. The capacity of every slot is the number of arguments, such that copying a model never allocates
+		 */
+		vector<vector<ID>> slotArguments;
+
+		/**
+		 * For each slot, the number of its model
+		 */
+		vector<unsigned long> slotModelNumbers;
+
+		/**
+		 * The number of models that have been added to the ring buffer. Only written by the search thread
+		 */
+		alignas(64) atomic<size_t> tail{ 0 };
+
+		/**
+		 * The number of models that have been passed to the sink. Only written by the writing thread
+		 */
+		alignas(64) atomic<size_t> head{ 0 };
+
+		/**
+		 * Indicates whether the writing thread sleeps until a model is added
+		 */
+		atomic<bool> isWriterSleeping{ false };
+
+		/**
+		 * Indicates whether the search thread sleeps until a slot is free
+		 */
+		atomic<bool> isSearchSleeping{ false };
+
+		/**
+		 * Indicates whether the writing thread should stop once the ring buffer is empty
+		 */
+		atomic<bool> isClosing{ false };
+
+		/**
+		 * Guards sleeping, such that a wake up is not lost
+		 */
+		mutex sleepMutex;
+
+		/**
+		 * Signals the writing thread that a model has been added
+		 */
+		condition_variable modelAdded;
+
+		/**
+		 * Signals the search thread that a slot has been freed
+		 */
+		condition_variable slotFreed;
+
+		/**
+		 * The thread passing the models to the sink
+		 */
+		thread writer;
+
+		/**
+		 * The number of times the search thread waited for a free slot
+		 */
+		unsigned long& waitCount;
+
+		/**
+		 * The time in seconds the search thread waited for free slots
+		 */
+		double& waitSeconds;
+
+		/**
+		 * The number of models that have been dropped since the ring buffer was full
+		 */
+		unsigned long& droppedModelCount;
+
+	public:
+		/**
+		 * Creates a sink passing the models of an instance with the given number of arguments to the given sink on a dedicated thread, and reports how long
+		 * the search waited and how many models were dropped to the given variables
+		 */
+		AsyncModelSink(unique_ptr<ModelSink> sink, size_t const& numberOfArguments, Backpressure const& backpressure, unsigned long& waitCount, double& waitSeconds, unsigned long& droppedModelCount);
+
+		AsyncModelSink(const AsyncModelSink& other) = delete;
+		AsyncModelSink& operator=(const AsyncModelSink& other) = delete;
+
+		/**
+		 * Passes the remaining models to the sink and stops the writing thread
+		 */
+		~AsyncModelSink() override;
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+
+		/**
+		 * Waits until every model has been passed to the sink and flushes it
+		 */
+		void flush() override;
+
+	private:
+		/**
+		 * Waits until the given number of slots are free
+		 */
+		void waitForFreeSlots(size_t const& freeSlots);
+
+		/**
+		 * The loop of the writing thread
+		 */
+		void writeModels();
+};
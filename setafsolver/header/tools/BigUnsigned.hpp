@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * An arbitrary-precision unsigned integer. Used for model counts that exceed the range of unsigned long
+ */
+class BigUnsigned
+{
+	private:
+		/**
+		 * The 32 bit limbs of the value, least significant first. Empty if the value is 0
+		 */
+		vector<uint32_t> limbs;
+
+		/**
+		 * Removes leading zero limbs
+		 */
+		void trim();
+
+	public:
+		/**
+		 * Creates a new value equal to the given one
+		 */
+		BigUnsigned(unsigned long const& value = 0);
+
+		BigUnsigned(const BigUnsigned& other) = default;
+		BigUnsigned(BigUnsigned&& other) = default;
+		BigUnsigned& operator=(const BigUnsigned& other) = default;
+		BigUnsigned& operator=(BigUnsigned&& other) = default;
+
+		/**
+		 * Adds the given value to this value
+		 */
+		BigUnsigned& operator+=(BigUnsigned const& other);
+
+		/**
+		 * Multiplies this value with the given value
+		 */
+		BigUnsigned& operator*=(BigUnsigned const& other);
+
+		bool operator==(BigUnsigned const& other) const;
+		bool operator<(BigUnsigned const& other) const;
+
+		/**
+		 * {@return True iff the value is 0}
+		 */
+		bool isZero() const;
+
+		/**
+		 * {@return the value or the largest unsigned long if the value does not fit}
+		 */
+		unsigned long toULongSaturated() const;
+
+		/**
+		 * {@return the value as double, infinity if it is out of range}
+		 */
+		double toDouble() const;
+
+		/**
+		 * {@return the decimal representation of the value}
+		 */
+		string toString() const;
+};
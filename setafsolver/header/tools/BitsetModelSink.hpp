@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../datamodel/Misc.hpp"
+#include "./ModelSink.hpp"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+
+class Instance;
+
+/**
+ * Writes the models to a binary file, such that they can be mapped into memory and processed with bitwise operations. The file starts with a header of 32 bytes:
+ * the magic SETAFBIT, the version and the compression as 32 bit integers and the number of arguments and the size of the names as 64 bit integers, all little endian.
+ * The names follow back to back, each terminated by a zero byte. The size of the names excludes the zeros that pad them as a whole to a multiple of 8 bytes, thus
+ * the models start at byte 32 plus the size of the names rounded up to a multiple of 8. Every model is a bitset of the arguments that are in, where
+ * the argument with id i is bit i % 8 of byte i / 8, padded with zeros to a multiple of 8 bytes, i.e. an array of little endian 64 bit words.
+ * If compressed, the header and names are not, while the bitsets form a single zlib or zstd stream.
+ * The models are collected in a large buffer, which is handed over to a dedicated thread that compresses it and writes it to the file
+ */
+class BitsetModelSink : public ModelSink
+{
+	public:
+		/**
+		 * The compressions of the bitsets
+		 */
+		enum class Compression { None = 0, Zlib = 1, Zstd = 2 };
+
+		/**
+		 * {@return the compression represented by the given string or none if it is unknown or not available in this build}
+		 */
+		static optional<Compression> tryParseCompression(char const* s);
+
+	private:
+		/**
+		 * The size of each buffer, after which it is handed over to the writing thread
+		 */
+		static constexpr size_t bufferSize = 1 << 22;
+
+		/**
+		 * The file to write to or null if it could not be opened
+		 */
+		FILE* file = nullptr;
+
+		/**
+		 * The compression of the bitsets
+		 */
+		Compression compression;
+
+		/**
+		 * The number of bytes of every bitset
+		 */
+		size_t bitsetSize;
+
+		/**
+		 * The buffer to which bitsets are added
+		 */
+		vector<char> buffer;
+
+		/**
+		 * The buffer that is written by the writing thread
+		 */
+		vector<char> pendingBuffer;
+
+		/**
+		 * The compressed bytes of the pending buffer. Only used by the writing thread
+		 */
+		vector<char> compressedBuffer;
+
+		/**
+		 * Indicates whether the pending buffer has not been written yet
+		 */
+		bool hasPendingBuffer = false;
+
+		/**
+		 * Indicates whether the writing thread should finish the compressed stream and stop once the pending buffer has been written
+		 */
+		bool isClosing = false;
+
+		/**
+		 * Guards the pending buffer and the flags
+		 */
+		mutex bufferMutex;
+
+		/**
+		 * Signals that a buffer has been handed over or written
+		 */
+		condition_variable bufferChanged;
+
+		/**
+		 * The thread writing the pending buffer
+		 */
+		thread writer;
+
+#ifdef HAVE_ZLIB
+		/**
+		 * The state of the zlib stream
+		 */
+		z_stream zlibStream{};
+#endif
+
+#ifdef HAVE_ZSTD
+		/**
+		 * The state of the zstd stream
+		 */
+		ZSTD_CCtx* zstdContext = nullptr;
+#endif
+
+	public:
+		/**
+		 * Creates a sink writing the models of the given instance to the given file with the given compression
+		 */
+		BitsetModelSink(char const* path, Instance& instance, Compression const& compression);
+
+		BitsetModelSink(const BitsetModelSink& other) = delete;
+		BitsetModelSink& operator=(const BitsetModelSink& other) = delete;
+
+		/**
+		 * Writes the remaining models and closes the file
+		 */
+		~BitsetModelSink() override;
+
+		/**
+		 * {@return True iff the file has been opened}
+		 */
+		bool isOpen() const;
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+
+		/**
+		 * Hands the collected models over to the writing thread
+		 */
+		void flush() override;
+
+		/**
+		 * Writes the remaining models, finishes the compressed stream and closes the file
+		 */
+		void close();
+
+	private:
+		/**
+		 * Appends the given integer in little endian with the given number of bytes to the buffer
+		 */
+		void addInteger(uint64_t value, size_t const& bytes);
+
+		/**
+		 * Waits until the pending buffer has been written and swaps it with the buffer
+		 */
+		void handOver();
+
+		/**
+		 * The loop of the writing thread
+		 */
+		void writePendingBuffers();
+
+		/**
+		 * Compresses the given bytes unless the compression is None and writes them. Finishes the compressed stream if requested
+		 */
+		void write(vector<char> const& bytes, bool const& isLast);
+};
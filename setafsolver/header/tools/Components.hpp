@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include "../datamodel/Misc.hpp"
+#include "../datamodel/Instance.hpp"
+
+using namespace std;
+
+/**
+ * Computes decompositions of the attack graph of an instance, i.e. the graph with an edge from every supporting argument of an attack to the attacked argument
+ */
+class Components
+{
+	public:
+		/**
+		 * Computes the strongly connected components of the attack graph
+		 * @param numberOfComponents Will be set to the number of components
+		 * @return for each argument by id the index of its component. The components are numbered in topological order, i.e. every attack either stays within a component or is directed at a component with a higher index
+		 */
+		static vector<ID> computeStronglyConnected(Instance& instance, ID& numberOfComponents);
+
+		/**
+		 * Computes the strongly connected components of a directed graph given by the successors of every node
+		 * @param numberOfComponents Will be set to the number of components
+		 * @return for each node the index of its component. The components are numbered in topological order
+		 */
+		static vector<ID> computeStronglyConnected(vector<vector<ID>> const& successors, ID& numberOfComponents);
+
+		/**
+		 * Computes the weakly connected components of the attack graph, i.e. the maximal sets of arguments that are connected via attacks regardless of their direction
+		 * @param numberOfComponents Will be set to the number of components
+		 * @return for each argument by id the index of its component. The components are numbered in order of their argument with the lowest id
+		 */
+		static vector<ID> computeWeaklyConnected(Instance& instance, ID& numberOfComponents);
+
+	private:
+		/**
+		 * {@return for each argument, all arguments that it attacks together with other arguments in the same support}
+		 */
+		static vector<vector<ID>> computeAttacks(Instance& instance);
+
+		/**
+		 * {@return the representative of the set containing the given argument in a union-find forest. Compresses the path on the way}
+		 */
+		static ID findRepresentative(vector<ID>& parents, ID argument);
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <optional>
+#include <cstdio>
+#include <sys/types.h>
+
+#include "../datamodel/Misc.hpp"
+#include "../datamodel/Instance.hpp"
+#include "./ModelSink.hpp"
+
+using namespace std;
+
+/**
+ * Expands the output of DeltaModelSink back to full models, which are passed to a model sink. A line "Model N" starts a keyframe, whose next line lists the names of
+ * the arguments that are in. Every following line that starts with + or - is the next model, given by the arguments that entered and left. All other lines, such as
+ * the summary of the solver, are copied unchanged
+ */
+class ModelDecoder
+{
+	private:
+		/**
+		 * The instance the models have been printed for
+		 */
+		Instance& instance;
+
+		/**
+		 * Receives the decoded models
+		 */
+		ModelSink& modelSink;
+
+		/**
+		 * The file the models are read from
+		 */
+		FILE* file = nullptr;
+
+		/**
+		 * For each argument name, its id or none if the name is not unique
+		 */
+		unordered_map<string_view, optional<ID>> idOfName;
+
+		/**
+		 * The line that has been read last. Member to avoid reallocation
+		 */
+		char* line = nullptr;
+
+		/**
+		 * The capacity of line
+		 */
+		size_t lineCapacity = 0;
+
+		/**
+		 * The ascending ids of the arguments that are in the current model
+		 */
+		vector<ID> arguments;
+
+		/**
+		 * The ascending ids of the arguments that are in the previous model. Member to avoid reallocation
+		 */
+		vector<ID> previousArguments;
+
+		/**
+		 * The ids of the arguments that entered or left, given in the order of the line. Member to avoid reallocation
+		 */
+		vector<pair<ID, bool>> changes;
+
+		/**
+		 * The number of the current model or 0 before the first keyframe
+		 */
+		unsigned long modelNumber = 0;
+
+		/**
+		 * The number of lines that have been read
+		 */
+		unsigned long lineCount = 0;
+
+		/**
+		 * The reason the stream has been rejected
+		 */
+		string error;
+
+	public:
+		/**
+		 * Creates a decoder for models of the given instance, which passes them to the given sink
+		 */
+		ModelDecoder(Instance& instance, ModelSink& modelSink);
+
+		ModelDecoder(const ModelDecoder& other) = delete;
+		ModelDecoder& operator=(const ModelDecoder& other) = delete;
+
+		~ModelDecoder();
+
+		/**
+		 * Decodes the models in the given file, which may be a pipe, or in standard input if the path is -
+		 * @return True iff every model has been decoded
+		 */
+		bool decode(char const* path);
+
+		/**
+		 * {@return the reason the stream has been rejected}
+		 */
+		string const& getError() const;
+
+		/**
+		 * {@return the number of the model that has been decoded last}
+		 */
+		unsigned long getModelCount() const;
+
+	private:
+		/**
+		 * Reads the next line into line, including its line break
+		 * @return the length of the line or -1 at the end of the file
+		 */
+		ssize_t readLine();
+
+		/**
+		 * Splits the given part of the current line at spaces into the ids of the named arguments, which have to be ascending
+		 * @param isDelta Indicates whether every name is prefixed by + or -, which is stored with the id in changes, otherwise the ids are stored in arguments
+		 * @return false if a name is unknown or not unique or the arguments are not ascending, in which case the error is set
+		 */
+		bool parseArguments(char* begin, char* end, bool const& isDelta);
+
+		/**
+		 * Applies the changes to the arguments of the previous model
+		 * @return false if an argument enters that is already in or leaves that is not in, in which case the error is set
+		 */
+		bool applyChanges();
+
+		/**
+		 * Sets the error to the given reason, prefixed by the current line
+		 * @return false
+		 */
+		bool reject(string const& reason);
+};
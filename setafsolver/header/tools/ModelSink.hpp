@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "../datamodel/Misc.hpp"
+
+using namespace std;
+
+class Instance;
+
+/**
+ * Receives the models found by the engines, one call per model. Every model is given by its number and the ascending ids of the arguments that are in
+ */
+class ModelSink
+{
+	public:
+		virtual ~ModelSink() = default;
+
+		/**
+		 * {@return True iff the engines have to pass every model with its arguments, otherwise the models are only counted}
+		 */
+		virtual bool requiresModels() const;
+
+		/**
+		 * Receives a model
+		 * @param inArguments The ascending ids of the arguments that are in
+		 */
+		virtual void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) = 0;
+
+		/**
+		 * Writes the models that have been received but not written yet
+		 */
+		virtual void flush();
+};
+
+/**
+ * Prints the models to stdout. The names of the arguments are copied once into a single arena, the models are formatted into a large buffer and every full
+ * buffer is written with a single call to write
+ */
+class TextModelSink : public ModelSink
+{
+	private:
+		/**
+		 * The size of the buffer, after which it is written
+		 */
+		static constexpr size_t bufferSize = 1 << 20;
+
+		/**
+		 * The names of all arguments one after another
+		 */
+		vector<char> names;
+
+		/**
+		 * For each argument, the index of its name in names. Contains one additional element marking the end of the last name
+		 */
+		vector<size_t> nameOffsets;
+
+	protected:
+		/**
+		 * The formatted models that have not been written yet
+		 */
+		vector<char> buffer;
+
+	public:
+		/**
+		 * Creates a sink printing the models with the names of the arguments of the given instance
+		 */
+		TextModelSink(Instance& instance);
+
+		TextModelSink(const TextModelSink& other) = delete;
+		TextModelSink& operator=(const TextModelSink& other) = delete;
+
+		/**
+		 * Writes the remaining models
+		 */
+		~TextModelSink() override;
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+
+		void flush() override;
+
+	protected:
+		/**
+		 * Appends the name of the given argument to the buffer
+		 */
+		void appendName(ID const& id);
+
+		/**
+		 * Writes the buffer if it is full
+		 */
+		void flushIfFull();
+};
+
+/**
+ * Prints the models to stdout as the changes to the previous model, which are few if the enumeration only flips the last decisions. Every model that starts an
+ * interval is printed in full like by TextModelSink, as keyframe from which a decoder can start. Every other model is a single line with the names of the arguments
+ * that entered prefixed by + and of those that left prefixed by -, in ascending order of the arguments
+ */
+class DeltaModelSink : public TextModelSink
+{
+	private:
+		/**
+		 * The number of models after which a keyframe is printed
+		 */
+		unsigned long keyframeInterval;
+
+		/**
+		 * The number of the model that has been printed last or 0
+		 */
+		unsigned long previousModelNumber = 0;
+
+		/**
+		 * The ascending ids of the arguments that are in the model that has been printed last
+		 */
+		vector<ID> previousArguments;
+
+	public:
+		/**
+		 * Creates a sink printing the models with the names of the arguments of the given instance, in full every keyframeInterval models
+		 */
+		DeltaModelSink(Instance& instance, unsigned long const& keyframeInterval);
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+};
+
+/**
+ * Discards the models, such that they are only counted by the engines
+ */
+class CountingModelSink : public ModelSink
+{
+	public:
+		bool requiresModels() const override;
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+};
+
+/**
+ * Passes every model to a function
+ */
+class CallbackModelSink : public ModelSink
+{
+	private:
+		/**
+		 * The function receiving the models
+		 */
+		function<void(unsigned long const&, vector<ID> const&)> callback;
+
+	public:
+		/**
+		 * Creates a sink passing every model to the given function
+		 */
+		CallbackModelSink(function<void(unsigned long const&, vector<ID> const&)> callback);
+
+		void addModel(unsigned long const& modelNumber, vector<ID> const& inArguments) override;
+};
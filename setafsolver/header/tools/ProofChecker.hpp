@@ -0,0 +1,503 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+
+#include "../datamodel/Misc.hpp"
+#include "../datamodel/Instance.hpp"
+#include "./ProofWriter.hpp"
+
+using namespace std;
+
+/**
+ * Checks a proof as written by ProofWriter against the instance it has been written for. The attacks are the input clauses, numbered by their position in the
+ * instance file, and the required arguments are unit clauses. A proof without hints has no numbers, its added clauses are numbered implicitly after the attacks and
+ * its deleted clauses are found by their literals. A derived clause with hints is checked by assigning its negation and propagating the hinted clauses one
+ * after another, which takes time linear in their size. A derived clause without hints is checked by unit propagation over all clauses that have not been deleted,
+ * using two watched literals per clause. An implicit clause is checked against the attacks on its first argument.
+ * The proof is consumed as it is read, thus it can be checked while it is written into a pipe. Deleted clauses are evicted and their literals are reclaimed once they
+ * make up half of the stored literals, such that the memory is bounded by the clauses that are alive at the same time rather than by the length of the proof.
+ * When recording, the clauses every added clause depends on are kept, i.e. its hints or the clauses found by analysing the conflict of unit propagation, such that
+ * the proof can be rewritten with the lines the empty clause depends on only
+ */
+class ProofChecker
+{
+	private:
+		/**
+		 * A literal, given by twice the id of its argument plus 1 if it is negated
+		 */
+		using Literal = ID;
+
+		/**
+		 * A line of the proof that added a clause, recorded for trimming
+		 */
+		struct RecordedLine
+		{
+			/**
+			 * The number of the added clause
+			 */
+			ID id = 0;
+
+			/**
+			 * The kind of the line, either a derived or an implicit clause
+			 */
+			ProofWriter::LineKind kind = ProofWriter::LineKind::Lemma;
+
+			/**
+			 * The index of the first literal in recordedLiterals
+			 */
+			size_t literalOffset = 0;
+
+			/**
+			 * The number of literals
+			 */
+			ID literalCount = 0;
+
+			/**
+			 * The index of the first dependency in recordedDependencies
+			 */
+			size_t dependencyOffset = 0;
+
+			/**
+			 * The number of clauses the added clause depends on
+			 */
+			ID dependencyCount = 0;
+
+			/**
+			 * Indicates whether the dependencies become unit one after another under the negation of the clause, thus can be written as hints
+			 */
+			bool isChain = false;
+		};
+
+		/**
+		 * A clause of the proof whose literals are stored in the literal arena
+		 */
+		struct StoredClause
+		{
+			/**
+			 * The index of the first literal in the arena
+			 */
+			size_t offset = 0;
+
+			/**
+			 * The number of literals
+			 */
+			ID size = 0;
+
+			/**
+			 * The number of the clause in the proof
+			 */
+			ID id = 0;
+
+			/**
+			 * Indicates whether the clause has been added and not deleted
+			 */
+			bool isActive = false;
+		};
+
+		/**
+		 * The size of the buffer the proof is read with
+		 */
+		static constexpr size_t readBufferSize = 1 << 20;
+
+		/**
+		 * The instance the proof has been written for
+		 */
+		Instance& instance;
+
+		/**
+		 * The encoding of the proof
+		 */
+		ProofWriter::Format format;
+
+		/**
+		 * Indicates whether the lines are numbered and derived clauses are written with the clauses they follow from
+		 */
+		bool isHinted;
+
+		/**
+		 * The proof file
+		 */
+		FILE* file = nullptr;
+
+		/**
+		 * The bytes read from the proof file that have not been consumed
+		 */
+		vector<char> readBuffer;
+
+		/**
+		 * The position of the next byte to consume in the read buffer
+		 */
+		size_t readPosition = 0;
+
+		/**
+		 * For text proofs, the positive literal of each argument name or none if the name is not unique
+		 */
+		unordered_map<string, optional<Literal>> literalOfName;
+
+		/**
+		 * The literals of the stored clauses
+		 */
+		vector<Literal> literals;
+
+		/**
+		 * The stored clauses in the order they have been added, including deleted ones until the next compaction
+		 */
+		vector<StoredClause> clauses;
+
+		/**
+		 * For each number of a clause that has not been deleted, its index in clauses. Subsumed attacks have been removed by the parser and do not occur
+		 */
+		unordered_map<ID, size_t> indexOfClause;
+
+		/**
+		 * For a proof without hints, the numbers of the clauses that have not been deleted by the hash of their literals
+		 */
+		unordered_map<uint64_t, vector<ID>> clausesOfHash;
+
+		/**
+		 * The literals of a clause sorted for comparison. Member to avoid reallocation
+		 */
+		vector<Literal> sortedLiterals;
+
+		/**
+		 * The number of the clause that has been added last, the following clause has to have a larger number
+		 */
+		ID lastClauseId = 0;
+
+		/**
+		 * The number of literals of the deleted clauses that are still stored
+		 */
+		size_t deletedLiteralCount = 0;
+
+		/**
+		 * The largest number of bytes taken by the stored clauses and their literals
+		 */
+		size_t peakClauseMemory = 0;
+
+		/**
+		 * For each literal, the indices of the clauses watching it. Contains deleted clauses until they are encountered during propagation
+		 */
+		vector<vector<size_t>> watches;
+
+		/**
+		 * The indices of the clauses with a single literal. Contains deleted clauses until they are encountered
+		 */
+		vector<size_t> unitClauses;
+
+		/**
+		 * The literals of the required arguments
+		 */
+		vector<Literal> requiredLiterals;
+
+		/**
+		 * The value of each argument, 0 if unassigned, 1 if in and -1 if out
+		 */
+		vector<Sign> values;
+
+		/**
+		 * The assigned literals in the order of assignment
+		 */
+		vector<Literal> trail;
+
+		/**
+		 * A helper vector marking arguments. Member to avoid reallocation
+		 */
+		vector<bool> isMarked;
+
+		/**
+		 * The kind of the line that has been read last
+		 */
+		ProofWriter::LineKind lineKind = ProofWriter::LineKind::Lemma;
+
+		/**
+		 * The number of the clause of the line that has been read last, 0 for deletions
+		 */
+		ID lineId = 0;
+
+		/**
+		 * The tokens of the text line that has been read last, only the first lineTokenCount are valid. Member to avoid reallocation
+		 */
+		vector<string> lineTokens;
+
+		/**
+		 * The number of valid tokens in lineTokens
+		 */
+		size_t lineTokenCount = 0;
+
+		/**
+		 * The literals of the line that has been read last, or the numbers of the deleted clauses
+		 */
+		vector<Literal> lineLiterals;
+
+		/**
+		 * The hints of the line that has been read last
+		 */
+		vector<ID> lineHints;
+
+		/**
+		 * The number of lines that have been read
+		 */
+		unsigned long lineCount = 0;
+
+		/**
+		 * The number of derived clauses checked with hints
+		 */
+		unsigned long hintedLemmaCount = 0;
+
+		/**
+		 * The number of derived clauses checked by unit propagation over all clauses
+		 */
+		unsigned long propagatedLemmaCount = 0;
+
+		/**
+		 * The number of implicit clauses
+		 */
+		unsigned long implicitClauseCount = 0;
+
+		/**
+		 * The number of deleted clauses
+		 */
+		unsigned long deletedClauseCount = 0;
+
+		/**
+		 * The reason the proof has been rejected
+		 */
+		string error;
+
+		/**
+		 * Indicates whether the added clauses are recorded with their dependencies
+		 */
+		bool isRecording;
+
+		/**
+		 * For each assigned argument, the number of the clause that implied its value, 0 for the negation of the current line and the required arguments
+		 */
+		vector<ID> reasons;
+
+		/**
+		 * The number of the clause falsified by the last conflict, 0 if a required argument has been falsified
+		 */
+		ID conflictClauseId = 0;
+
+		/**
+		 * The clauses the current line depends on
+		 */
+		vector<ID> lineDependencies;
+
+		/**
+		 * Indicates whether the dependencies of the current line can be written as hints
+		 */
+		bool isLineChain = false;
+
+		/**
+		 * The recorded lines in the order of the proof, thus sorted by their numbers
+		 */
+		vector<RecordedLine> recordedLines;
+
+		/**
+		 * The literals of the recorded lines
+		 */
+		vector<Literal> recordedLiterals;
+
+		/**
+		 * The dependencies of the recorded lines
+		 */
+		vector<ID> recordedDependencies;
+
+	public:
+		/**
+		 * Creates a checker for proofs of the given instance in the given format, with or without hints, which records the added clauses for trimming if requested
+		 */
+		ProofChecker(Instance& instance, ProofWriter::Format const& format, bool const& isHinted, bool const& isRecording);
+
+		ProofChecker(const ProofChecker& other) = delete;
+		ProofChecker& operator=(const ProofChecker& other) = delete;
+
+		/**
+		 * Checks the proof in the given file, which may be a pipe, or in standard input if the path is -
+		 * @return True iff every line is correct and the proof derives the empty clause
+		 */
+		bool check(char const* path);
+
+		/**
+		 * {@return the reason the proof has been rejected}
+		 */
+		string const& getError() const;
+
+		/**
+		 * {@return the number of derived clauses checked with hints}
+		 */
+		unsigned long getHintedLemmaCount() const;
+
+		/**
+		 * {@return the number of derived clauses checked by unit propagation over all clauses}
+		 */
+		unsigned long getPropagatedLemmaCount() const;
+
+		/**
+		 * {@return the number of implicit clauses}
+		 */
+		unsigned long getImplicitClauseCount() const;
+
+		/**
+		 * {@return the number of deleted clauses}
+		 */
+		unsigned long getDeletedClauseCount() const;
+
+		/**
+		 * {@return the largest number of bytes taken by the stored clauses and their literals}
+		 */
+		size_t getPeakClauseMemory() const;
+
+		/**
+		 * Writes the recorded lines the empty clause depends on, renumbered, with hints wherever the dependencies form a chain. Every clause is deleted after its last use.
+		 * Requires a verified proof that has been recorded
+		 * @return the number of derived clauses that have been written
+		 */
+		unsigned long writeTrimmedProof(ProofWriter& writer) const;
+
+	private:
+		/**
+		 * Processes the lines of the proof until the empty clause has been derived
+		 * @return True iff the empty clause has been derived
+		 */
+		bool checkLines();
+
+		/**
+		 * Reads the next line into lineKind, lineId, lineLiterals and lineHints
+		 * @return false at the end of the file or if the line is malformed, in which case the error is set
+		 */
+		bool readLine();
+
+		/**
+		 * Reads the next line of a text proof
+		 * @return false at the end of the file or if the line is malformed, in which case the error is set
+		 */
+		bool readTextLine();
+
+		/**
+		 * Reads the next line of a binary proof
+		 * @return false at the end of the file or if the line is malformed, in which case the error is set
+		 */
+		bool readBinaryLine();
+
+		/**
+		 * {@return the next byte of the proof file or -1 at its end}
+		 */
+		int readByte();
+
+		/**
+		 * Reads a variable length integer of a binary proof
+		 * @return false if the file ends within the integer
+		 */
+		bool readVariableLengthInteger(ID& value);
+
+		/**
+		 * Splits the next text line into lineTokens
+		 * @return false at the end of the file
+		 */
+		bool readTextTokens();
+
+		/**
+		 * Parses a clause number of a text proof, which is not 0
+		 * @return false if the token is no such number
+		 */
+		bool parseNumber(string const& token, ID& number) const;
+
+		/**
+		 * Parses a literal of a text proof, given by the name of its argument with a leading - if it is negated
+		 * @return false if the argument is unknown or its name is not unique
+		 */
+		bool parseLiteral(string& token, Literal& literal) const;
+
+		/**
+		 * Sets the error to the given reason, prefixed by the current line
+		 * @return false
+		 */
+		bool reject(string const& reason);
+
+		/**
+		 * Adds the given clause with the given number, watching its first two literals
+		 */
+		void addClause(ID const& id, vector<Literal> const& clauseLiterals);
+
+		/**
+		 * Deactivates the clause with the given number and compacts the stored clauses if half of the literals belong to deleted clauses
+		 * @return false if there is no such clause, in which case the error is set
+		 */
+		bool deleteClause(ID const& id);
+
+		/**
+		 * Deactivates the clause of a proof without hints that has the literals of the current line
+		 * @return false if there is no such clause, in which case the error is set
+		 */
+		bool deleteClauseWithLiterals();
+
+		/**
+		 * {@return the hash of the given literals, which does not depend on their order}
+		 */
+		static uint64_t hashLiterals(Literal const* begin, Literal const* end);
+
+		/**
+		 * Removes the deleted clauses and their literals, moving the remaining ones to the front, and rebuilds the watches
+		 */
+		void compact();
+
+		/**
+		 * {@return True iff the implicit clause of the current line contains its first argument and, for every attack on it that is not a self attack, a supporting argument}
+		 */
+		bool checkImplicitClause();
+
+		/**
+		 * {@return True iff the negation of the current line is refuted by the hinted clauses becoming unit one after another}
+		 */
+		bool checkHints();
+
+		/**
+		 * {@return True iff unit propagation over all clauses refutes the negation of the current line}
+		 */
+		bool checkByPropagation();
+
+		/**
+		 * Assigns the negation of the literals of the current line
+		 * @return True iff the line contains a literal and its negation, thus holds trivially
+		 */
+		bool assignNegation();
+
+		/**
+		 * Propagates the assignments on the trail from the given position with the watched literals
+		 * @return True iff a conflict occurred
+		 */
+		bool propagate(size_t position);
+
+		/**
+		 * Undoes all assignments
+		 */
+		void undo();
+
+		/**
+		 * {@return the value of the given literal, 0 if unassigned, 1 if true and -1 if false}
+		 */
+		Sign valueOf(Literal const& literal) const;
+
+		/**
+		 * Collects the clauses the last conflict depends on into lineDependencies, in the order they became unit followed by the falsified clause, by walking the
+		 * assignments that follow the negation of the line backwards
+		 */
+		void collectDependencies(size_t const& negationSize);
+
+		/**
+		 * Records the current line with its dependencies
+		 */
+		void recordLine();
+
+		/**
+		 * Assigns the given literal to true, implied by the clause with the given number or 0
+		 */
+		void assign(Literal const& literal, ID const& reason);
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../datamodel/Misc.hpp"
+
+using namespace std;
+
+class Argument;
+class Clause;
+
+/**
+ * Writes the proof, either as text or binary. The lines are collected in a large buffer, which is handed over to a dedicated thread that writes it to the file,
+ * while the lines that follow are collected in a second buffer. The search thread only waits if the file is written slower than the proof is produced.
+ * With hints, every added clause is numbered after the attacks of the instance file and derived clauses list the clauses they follow from, such that they are checked
+ * without searching the whole clause set. Deleted clauses are then given by their numbers
+ */
+class ProofWriter
+{
+	public:
+		/**
+		 * The encodings of the proof
+		 */
+		enum class Format { Text, Binary };
+
+		/**
+		 * The kinds of lines of the proof, i.e. clauses that follow by unit propagation, implicit clauses given by the semantics and deleted clauses
+		 */
+		enum class LineKind { Lemma, Implicit, Deletion };
+
+	private:
+		/**
+		 * The size of each buffer, after which it is handed over to the writing thread
+		 */
+		static constexpr size_t bufferSize = 1 << 22;
+
+		/**
+		 * The file to write to or null if it could not be opened
+		 */
+		FILE* file = nullptr;
+
+		/**
+		 * The encoding of the proof
+		 */
+		Format format;
+
+		/**
+		 * Indicates whether the lines are numbered and derived clauses are written with the clauses they follow from
+		 */
+		bool isHinted;
+
+		/**
+		 * The number of the next clause added to the proof
+		 */
+		ID nextClauseId = 1;
+
+		/**
+		 * The buffer to which lines are added
+		 */
+		vector<char> buffer;
+
+		/**
+		 * The buffer that is written by the writing thread
+		 */
+		vector<char> pendingBuffer;
+
+		/**
+		 * Indicates whether the pending buffer has not been written yet
+		 */
+		bool hasPendingBuffer = false;
+
+		/**
+		 * Indicates whether the writing thread should stop once the pending buffer has been written
+		 */
+		bool isClosing = false;
+
+		/**
+		 * Guards the pending buffer and the flags
+		 */
+		mutex bufferMutex;
+
+		/**
+		 * Signals that a buffer has been handed over or written
+		 */
+		condition_variable bufferChanged;
+
+		/**
+		 * The thread that writes the pending buffers
+		 */
+		thread writer;
+
+	public:
+		/**
+		 * Opens the given file and starts the writing thread. The path - denotes standard output, which is then reserved for the proof: the other output of the program
+		 * is redirected to standard error, such that the proof can be piped into a checker
+		 */
+		ProofWriter(char const* path, Format const& format, bool const& isHinted);
+
+		ProofWriter(const ProofWriter& other) = delete;
+		ProofWriter& operator=(const ProofWriter& other) = delete;
+
+		/**
+		 * Writes the remaining lines and closes the file
+		 */
+		~ProofWriter();
+
+		/**
+		 * {@return True iff the file has been opened}
+		 */
+		bool isOpen() const;
+
+		/**
+		 * {@return True iff the lines are numbered and derived clauses are written with the clauses they follow from}
+		 */
+		bool hasHints() const;
+
+		/**
+		 * Sets the number of clauses given by the instance file, after which the added clauses are numbered
+		 */
+		void setNumberOfInputClauses(ID const& numberOfInputClauses);
+
+		/**
+		 * Adds a line with the members of the given clause. Unless the clause is deleted, its proof id is set to the number of the line
+		 * @return the number of the added clause or 0 for a deletion
+		 */
+		ID writeClause(LineKind const& kind, Clause& clause);
+
+		/**
+		 * Adds a line with the given literals
+		 * @return the number of the added clause or 0 for a deletion
+		 */
+		ID writeClause(LineKind const& kind, vector<pair<Argument*, Sign>> const& literals);
+
+		/**
+		 * Adds a derived clause with the proof ids of the clauses that become unit one after another under its negation, ending with the falsified one. Without hints or if
+		 * none are given, the clause has to follow by unit propagation over all clauses. Sets the proof id of the clause to the number of the line
+		 * @return the number of the added clause
+		 */
+		ID writeLemma(Clause& clause, vector<ID> const& hints);
+
+		/**
+		 * Adds a derived clause with the given literals and hints, see writeLemma above
+		 * @return the number of the added clause
+		 */
+		ID writeLemma(vector<pair<Argument*, Sign>> const& literals, vector<ID> const& hints);
+
+		/**
+		 * Deletes the clauses with the given numbers in a single line. Requires hints
+		 */
+		void writeDeletion(vector<ID> const& ids);
+
+		/**
+		 * Adds the empty clause, which concludes the proof
+		 */
+		void writeEmptyClause();
+
+		/**
+		 * Writes the remaining lines, stops the writing thread and closes the file
+		 */
+		void close();
+
+	private:
+		/**
+		 * Adds the start of a line of the given kind
+		 * @return the number of the added clause or 0 for a deletion
+		 */
+		ID beginLine(LineKind const& kind);
+
+		/**
+		 * Adds a literal to the current line
+		 */
+		void addLiteral(Argument const& argument, Sign const& sign);
+
+		/**
+		 * Adds a clause number, in text as decimal followed by a blank
+		 */
+		void addNumber(ID const& number);
+
+		/**
+		 * Terminates the current line, followed by the given hints for derived clauses if the proof has hints, and hands the buffer over if it is full
+		 */
+		void endLine(LineKind const& kind, vector<ID> const* hints);
+
+		/**
+		 * Adds the given number as a variable length integer, seven bits per byte starting with the lowest and the highest bit marking that more bytes follow
+		 */
+		void addVariableLengthInteger(uint64_t value);
+
+		/**
+		 * Waits until the pending buffer has been written and hands the current buffer over to the writing thread
+		 */
+		void handOver();
+
+		/**
+		 * Writes the pending buffers until the writer is closed. Once writing failed, e.g. because the reading end of a pipe has been closed, the buffers are discarded.
+		 * Run by the writing thread
+		 */
+		void writePendingBuffers();
+};
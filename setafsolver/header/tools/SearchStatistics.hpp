@@ -0,0 +1,102 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+/**
+ * The counters of the search of a solver. They are only incremented if STATISTICS is defined in Misc.hpp. Every solver owns its counters, which are aligned to
+ * their own cache lines, such that counting does not evict the data used by the propagation
+ */
+struct alignas(64) SearchStatistics
+{
+	/**
+	 * The number of guesses
+	 */
+	unsigned long decisions = 0;
+
+	/**
+	 * The number of assignments, including the guesses
+	 */
+	unsigned long propagations = 0;
+
+	/**
+	 * The number of conflicts that have been analysed
+	 */
+	unsigned long conflicts = 0;
+
+	/**
+	 * The number of learned clauses
+	 */
+	unsigned long learnedClauses = 0;
+
+	/**
+	 * The total number of literals of the learned clauses
+	 */
+	unsigned long learnedLiterals = 0;
+
+	/**
+	 * The number of learned clauses that have been forgotten
+	 */
+	unsigned long forgottenClauses = 0;
+
+	/**
+	 * The largest number of learned clauses that have not been forgotten at any time
+	 */
+	unsigned long peakLearnedClauses = 0;
+
+	/**
+	 * The number of back jumps after a conflict
+	 */
+	unsigned long backjumps = 0;
+
+	/**
+	 * The total number of decision levels undone by the back jumps
+	 */
+	unsigned long backjumpDistance = 0;
+
+	/**
+	 * The largest number of decision levels undone by a single back jump
+	 */
+	unsigned long maximumBackjumpDistance = 0;
+
+	/**
+	 * The number of times a clause watch has been moved to another argument
+	 */
+	unsigned long watchMoves = 0;
+
+	/**
+	 * The number of times the attacks on an argument have been searched for a new stability witness
+	 */
+	unsigned long stabilityRecomputations = 0;
+
+	/**
+	 * Adds the counters of the given statistics, the peaks are combined by their maximum
+	 */
+	SearchStatistics& operator+=(SearchStatistics const& other);
+
+	/**
+	 * {@return True iff no assignment has been counted, e.g. as the engine does not count}
+	 */
+	bool isEmpty() const;
+
+	/**
+	 * {@return the average number of literals of the learned clauses}
+	 */
+	double getAverageLearnedClauseSize() const;
+
+	/**
+	 * {@return the average number of decision levels undone by a back jump}
+	 */
+	double getAverageBackjumpDistance() const;
+
+	/**
+	 * Prints the counters to stdout, one line per group
+	 */
+	void print() const;
+
+	/**
+	 * {@return the counters as JSON object}
+	 */
+	string toJson() const;
+};
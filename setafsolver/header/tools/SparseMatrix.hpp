@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "../datamodel/Misc.hpp"
+
+using namespace std;
+
+/**
+ * A sparse matrix in compressed sparse row (CSR) format. Used to propagate heuristics values along the attacks of an instance
+ */
+class SparseMatrix
+{
+	private:
+		/**
+		 * For each row, the index of its first entry in columns and values. Contains one additional element that marks the end of the last row
+		 */
+		vector<size_t> rowOffsets;
+
+		/**
+		 * The column of each entry, grouped by row
+		 */
+		vector<ID> columns;
+
+		/**
+		 * The value of each entry, grouped by row. Empty if every entry has the value 1
+		 */
+		vector<double> values;
+
+		/**
+		 * For each row, the index at which the next entry is added. Only used while the matrix is filled
+		 */
+		vector<size_t> fillPositions;
+
+	public:
+		/**
+		 * Creates a new matrix with the given number of entries per row
+		 * @param isWeighted If false, every entry has the value 1 and the values passed to addEntry are ignored
+		 */
+		SparseMatrix(vector<size_t> const& rowSizes, bool const& isWeighted);
+
+		SparseMatrix(const SparseMatrix& other) = default;
+		SparseMatrix(SparseMatrix&& other) = default;
+		SparseMatrix& operator=(const SparseMatrix& other) = default;
+		SparseMatrix& operator=(SparseMatrix&& other) = default;
+
+		/**
+		 * Adds an entry to the given row. Every row must receive exactly the number of entries given at construction
+		 */
+		void addEntry(ID const& row, ID const& column, double const& value = 1.0);
+
+		/**
+		 * {@return the number of rows}
+		 */
+		size_t getNumberOfRows() const;
+
+		/**
+		 * {@return the number of entries}
+		 */
+		size_t getNumberOfEntries() const;
+
+		/**
+		 * Computes output = scale * (this * input). The rows are computed in parallel if the solver is built with OpenMP
+		 */
+		void multiply(vector<double> const& input, vector<double>& output, double const& scale) const;
+};
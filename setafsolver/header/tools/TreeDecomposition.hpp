@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <limits>
+
+#include "../datamodel/Misc.hpp"
+#include "../datamodel/Instance.hpp"
+
+using namespace std;
+
+/**
+ * A tree decomposition of the primal graph of an instance, i.e. the graph in which all arguments of an attack (the attacked and the supporting ones) are pairwise adjacent.
+ * The decomposition is derived from an elimination order: bag k contains the k-th eliminated argument first, followed by its neighbors at the time of its elimination.
+ * The parent of a bag is the bag of its neighbor that is eliminated first, thus children always have lower indices than their parents
+ */
+class TreeDecomposition
+{
+	public:
+		/**
+		 * Marks a bag without parent
+		 */
+		static constexpr size_t noParent = numeric_limits<size_t>::max();
+
+	private:
+		/**
+		 * The bags in elimination order
+		 */
+		vector<vector<ID>> bags;
+
+		/**
+		 * For each bag, the index of its parent bag or noParent
+		 */
+		vector<size_t> parents;
+
+		/**
+		 * For each bag, the indices of its child bags
+		 */
+		vector<vector<size_t>> children;
+
+		/**
+		 * The width of the decomposition, i.e. the size of the largest bag minus 1
+		 */
+		size_t width = 0;
+
+		TreeDecomposition() = default;
+
+	public:
+		/**
+		 * Computes a tree decomposition using the min-degree heuristic, ties are broken by the min-fill heuristic
+		 * {@return the decomposition or none if its width would exceed maximumWidth. Aborts as soon as this is known}
+		 */
+		static optional<TreeDecomposition> tryCompute(Instance& instance, size_t const& maximumWidth);
+
+		/**
+		 * {@return the number of bags, which equals the number of arguments}
+		 */
+		size_t getNumberOfBags() const;
+
+		/**
+		 * {@return the bag with the given index, starting with the argument eliminated in it}
+		 */
+		vector<ID> const& getBag(size_t const& index) const;
+
+		/**
+		 * {@return the index of the parent of the given bag or noParent}
+		 */
+		size_t getParent(size_t const& index) const;
+
+		/**
+		 * {@return the indices of the children of the given bag}
+		 */
+		vector<size_t> const& getChildren(size_t const& index) const;
+
+		/**
+		 * {@return the width of the decomposition}
+		 */
+		size_t getWidth() const;
+
+	private:
+		/**
+		 * {@return the number of edges that eliminating the given argument would add to the graph}
+		 */
+		static size_t computeFill(vector<vector<ID>> const& adjacency, ID const& argument);
+};
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <limits>
+
+#include "../header/ComponentSolver.hpp"
+#include "../header/Solver.hpp"
+#include "../header/tools/Components.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/Preprocessor.hpp"
+
+ComponentSolver::ComponentSolver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, optional<BigUnsigned>& exactModelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, bool const& sccRecursive, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ProofWriter>& proofFile) :
+	instance(instance),
+	semantics(semantics),
+	heuristics(heuristics),
+	firstModelTime(firstModelTime),
+	modelCount(modelCount),
+	exactModelCount(exactModelCount),
+	percentageSolved(percentageSolved),
+	numberOfModels(numberOfModels),
+	modelSink(modelSink),
+	printModels(modelSink.requiresModels()),
+	sccRecursive(sccRecursive),
+	clForgetPercentage(clForgetPercentage),
+	clGrowthRate(clGrowthRate),
+	proofFile(proofFile)
+{};
+
+void ComponentSolver::solve()
+{
+	decompose();
+
+	//Nothing to split, thus we solve the instance as a whole
+	if (componentArguments.size() <= 1)
+	{
+		dispatchSolverPolicy(proofFile != nullptr, useStabilityCounters, [&](auto policy)
+		{
+			Solver<decltype(policy)> solver(instance, semantics, heuristics, firstModelTime, modelCount, percentageSolved, numberOfModels, modelSink, sccRecursive, clForgetPercentage, clGrowthRate, proofFile);
+			solver.setReconstruction(reconstruction);
+			solver.setProbingBudget(probingBudget);
+			solver.setDetectEquivalences(detectEquivalences);
+			solver.solve();
+			statistics += solver.getStatistics();
+		});
+		return;
+	}
+
+	componentModels.resize(componentArguments.size());
+	BigUnsigned product(1);
+	for (size_t i = 0; i < componentArguments.size(); i++)
+	{
+		unsigned long count;
+		double componentPercentageSolved;
+		if (!solveComponent(i, count, componentPercentageSolved))
+		{
+			percentageSolved = (i + componentPercentageSolved) / componentArguments.size();
+			return; //Solver interrupted by signal
+		}
+
+		product *= BigUnsigned(count);
+		if (count == 0)
+			break; //The component has no extension, thus the instance has none
+	}
+	percentageSolved = 1.0;
+
+	if (printModels && !product.isZero())
+	{
+		enumerateProduct();
+		return;
+	}
+
+	//Only count
+	if (numberOfModels != 0 && BigUnsigned(numberOfModels) < product)
+		product = BigUnsigned(numberOfModels);
+	modelCount = product.toULongSaturated();
+	if (modelCount != 0)
+		firstModelTime = chrono::high_resolution_clock::now();
+	exactModelCount = product;
+}
+
+void ComponentSolver::setReconstruction(Preprocessor const* reconstruction)
+{
+	this->reconstruction = reconstruction;
+}
+
+void ComponentSolver::setProbingBudget(unsigned long const& probingBudget)
+{
+	this->probingBudget = probingBudget;
+}
+
+void ComponentSolver::setDetectEquivalences(bool const& detectEquivalences)
+{
+	this->detectEquivalences = detectEquivalences;
+}
+
+void ComponentSolver::setUseStabilityCounters(bool const& useStabilityCounters)
+{
+	this->useStabilityCounters = useStabilityCounters;
+}
+
+SearchStatistics const& ComponentSolver::getStatistics() const
+{
+	return statistics;
+}
+
+void ComponentSolver::decompose()
+{
+	ID numberOfComponents;
+	auto componentOfArgument = Components::computeWeaklyConnected(instance, numberOfComponents);
+
+	vector<vector<ID>> arguments(numberOfComponents), attacks(numberOfComponents);
+	for (ID i = 0; i < instance.getNumberOfArguments(); i++)
+		arguments[componentOfArgument[i]].push_back(i);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+		attacks[componentOfArgument[begin->getAttackedArgument().getId()]].push_back(begin->getId());
+
+	//Arguments that are not involved in any attack are always in. We collect them into one component to avoid a solver for each of them
+	const ID unassigned = numeric_limits<ID>::max();
+	vector<ID> finalComponent(numberOfComponents, unassigned);
+	ID isolatedComponent = unassigned;
+	for (ID i = 0; i < numberOfComponents; i++)
+	{
+		bool isIsolated = attacks[i].empty();
+		if (isIsolated && isolatedComponent != unassigned)
+		{
+			finalComponent[i] = isolatedComponent;
+			componentArguments[isolatedComponent].push_back(arguments[i][0]);
+			continue;
+		}
+
+		finalComponent[i] = componentArguments.size();
+		if (isIsolated)
+			isolatedComponent = finalComponent[i];
+		componentArguments.push_back(std::move(arguments[i]));
+		componentAttacks.push_back(std::move(attacks[i]));
+	}
+
+	//The isolated arguments have been added out of order
+	if (isolatedComponent != unassigned)
+		sort(componentArguments[isolatedComponent].begin(), componentArguments[isolatedComponent].end());
+
+	localIds.resize(instance.getNumberOfArguments());
+	for (auto& argumentIds : componentArguments)
+		for (ID i = 0; i < argumentIds.size(); i++)
+			localIds[argumentIds[i]] = i;
+
+	componentRequiredArguments.resize(componentArguments.size());
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end; begin++)
+	{
+		auto& [argument, sign] = *begin;
+		componentRequiredArguments[finalComponent[componentOfArgument[argument->getId()]]].emplace_back(localIds[argument->getId()], sign);
+	}
+}
+
+bool ComponentSolver::solveComponent(size_t const& index, unsigned long& count, double& componentPercentageSolved)
+{
+	if (Helper::receivedSignal())
+	{
+		componentPercentageSolved = 0;
+		return false;
+	}
+
+	auto subInstance = instance.getSubInstance(componentArguments[index], componentAttacks[index], localIds);
+	for (auto& [id, sign] : componentRequiredArguments[index])
+		subInstance.addRequiredArgument(subInstance.getArgument(id), sign);
+
+	//Every combination of models uses at most numberOfModels models of each component
+	chrono::time_point<chrono::high_resolution_clock> componentFirstModelTime;
+	unsigned long componentNumberOfModels = printModels ? numberOfModels : 0;
+	count = 0;
+	componentPercentageSolved = 0;
+
+	//The models of the component are collected for the combinations, unless they are only counted
+	CallbackModelSink collector([&](unsigned long const&, vector<ID> const& inArguments) { componentModels[index].push_back(inArguments); });
+	CountingModelSink counter;
+	ModelSink& componentModelSink = printModels ? (ModelSink&)collector : counter;
+
+	dispatchSolverPolicy(proofFile != nullptr, useStabilityCounters, [&](auto policy)
+	{
+		Solver<decltype(policy)> solver(subInstance, semantics, heuristics, componentFirstModelTime, count, componentPercentageSolved, componentNumberOfModels, componentModelSink, sccRecursive, clForgetPercentage, clGrowthRate, proofFile);
+		solver.setProbingBudget(probingBudget);
+		solver.setDetectEquivalences(detectEquivalences);
+		solver.solve();
+		statistics += solver.getStatistics();
+	});
+
+	return !Helper::receivedSignal();
+}
+
+void ComponentSolver::enumerateProduct()
+{
+	//Odometer over the models of the components, the first component changes fastest
+	vector<size_t> selection(componentArguments.size(), 0);
+	vector<ID> inArguments, originalArguments;
+	while (!Helper::receivedSignal())
+	{
+		//Record the first model time
+		if (modelCount == 0)
+			firstModelTime = chrono::high_resolution_clock::now();
+		modelCount++;
+
+		inArguments.clear();
+		for (size_t i = 0; i < selection.size(); i++)
+			for (auto& localId : componentModels[i][selection[i]])
+				inArguments.push_back(componentArguments[i][localId]);
+		sort(inArguments.begin(), inArguments.end());
+
+		//Pass the model
+		if (reconstruction != nullptr)
+		{
+			reconstruction->reconstructModel(inArguments, originalArguments);
+			modelSink.addModel(modelCount, originalArguments);
+		}
+		else
+			modelSink.addModel(modelCount, inArguments);
+
+		if (numberOfModels == modelCount)
+			return; //Required number of models found
+
+		//Advance to the next combination
+		size_t component = 0;
+		for (; component < selection.size(); component++)
+		{
+			if (++selection[component] < componentModels[component].size())
+				break;
+			selection[component] = 0;
+		}
+
+		if (component == selection.size())
+			return; //All combinations printed
+	}
+}
@@ -0,0 +1,446 @@
+#include <cmath>
+#include <algorithm>
+
+#include "../header/FixedAritySolver.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/Preprocessor.hpp"
+
+template <size_t Arity>
+FixedAritySolver<Arity>::FixedAritySolver(Instance& instance, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink) :
+	instance(instance),
+	heuristics(heuristics),
+	firstModelTime(firstModelTime),
+	modelCount(modelCount),
+	percentageSolved(percentageSolved),
+	numberOfModels(numberOfModels),
+	modelSink(modelSink),
+	printModels(modelSink.requiresModels())
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	//The parser removes the attacked argument from the members of a self attack, but it is part of the support
+	attacks.reserve(instance.getNumberOfAttacks());
+	attacksOnOffsets.assign(numberOfArguments + 1, 0);
+	supportedAttacksOffsets.assign(numberOfArguments + 1, 0);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto& attack = attacks.emplace_back();
+		attack.target = memberBegin->first->getId();
+		attack.size = 0;
+		if (begin->isSelfAttack())
+			attack.support[attack.size++] = attack.target;
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			attack.support[attack.size++] = memberBegin->first->getId();
+
+		attacksOnOffsets[attack.target + 1]++;
+		for (unsigned char i = 0; i < attack.size; i++)
+			supportedAttacksOffsets[attack.support[i] + 1]++;
+	}
+
+	for (ID i = 0; i < numberOfArguments; i++)
+	{
+		attacksOnOffsets[i + 1] += attacksOnOffsets[i];
+		supportedAttacksOffsets[i + 1] += supportedAttacksOffsets[i];
+	}
+
+	attacksOn.resize(attacksOnOffsets[numberOfArguments]);
+	supportedAttacks.resize(supportedAttacksOffsets[numberOfArguments]);
+	vector<size_t> attacksOnFill(attacksOnOffsets.begin(), attacksOnOffsets.end() - 1), supportedAttacksFill(supportedAttacksOffsets.begin(), supportedAttacksOffsets.end() - 1);
+	for (ID i = 0; i < attacks.size(); i++)
+	{
+		auto& attack = attacks[i];
+		attacksOn[attacksOnFill[attack.target]++] = i;
+		for (unsigned char j = 0; j < attack.size; j++)
+			supportedAttacks[supportedAttacksFill[attack.support[j]]++] = i;
+	}
+
+	values.assign(numberOfArguments, 0);
+	levels.resize(numberOfArguments);
+	trailPositions.resize(numberOfArguments);
+	reasons.resize(numberOfArguments);
+	visitedInAnalysis.assign(numberOfArguments, 0);
+	outMembers.assign(attacks.size(), 0);
+	unassignedMembers.resize(attacks.size());
+	liveAttacks.resize(numberOfArguments);
+	for (ID i = 0; i < attacks.size(); i++)
+		unassignedMembers[i] = attacks[i].size;
+	for (ID i = 0; i < numberOfArguments; i++)
+		liveAttacks[i] = attacksOnOffsets[i + 1] - attacksOnOffsets[i];
+	trail.reserve(numberOfArguments);
+};
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::setReconstruction(Preprocessor const* reconstruction)
+{
+	this->reconstruction = reconstruction;
+}
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::solve()
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	//Unattacked arguments are in, attacks without support defeat their target
+	Reason const guess = { ReasonType::Decision, 0 };
+	bool isConsistent = true;
+	for (ID i = 0; i < numberOfArguments && isConsistent; i++)
+		if (liveAttacks[i] == 0)
+			isConsistent = assign(i, 1, guess);
+	for (ID i = 0; i < attacks.size() && isConsistent; i++)
+		if (attacks[i].size == 0)
+			isConsistent = assign(attacks[i].target, -1, guess);
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end && isConsistent; begin++)
+		isConsistent = assign(begin->first->getId(), begin->second, guess);
+	if (!isConsistent || !propagate())
+	{
+		percentageSolved = 1.0;
+		return;
+	}
+
+	auto [sortedArguments, sortedGuesses] = heuristics.apply(instance, 0);
+	guessOrder.reserve(sortedArguments.size());
+	for (auto& argument : sortedArguments)
+		guessOrder.push_back(argument->getId());
+	guesses = std::move(sortedGuesses);
+	levelConflicts.resize(guessOrder.size() + 1);
+	isLevelAdded.assign(guessOrder.size() + 1, false);
+
+	vector<DL> conflictLevels;
+	while (true)
+	{
+		if (Helper::receivedSignal())
+		{
+			percentageSolved = solved; //Solver interrupted by signal
+			return;
+		}
+
+		while (guessPosition < guessOrder.size() && values[guessOrder[guessPosition]] != 0)
+			guessPosition++;
+
+		if (guessPosition == guessOrder.size())
+		{
+			if (printModel())
+			{
+				percentageSolved = solved + pow(0.5, decisions.size());
+				return;
+			}
+
+			//Every guess has to be flipped to find the other models, thus the search backtracks chronologically
+			conflictLevels.clear();
+			for (DL level = 1; level <= decisions.size(); level++)
+				conflictLevels.push_back(level);
+		}
+		else
+		{
+			decisions.push_back({ trail.size(), guessPosition, false, solved });
+			levelConflicts[decisions.size()].clear();
+			assign(guessOrder[guessPosition], guesses[guessPosition], guess);
+			if (propagate())
+				continue;
+			analyzeConflict(conflictLevels);
+		}
+
+		if (!backjump(conflictLevels))
+			break;
+	}
+
+	percentageSolved = 1.0;
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::backjump(vector<DL>& conflictLevels)
+{
+	Reason const guess = { ReasonType::Decision, 0 };
+	while (true)
+	{
+		//The guesses above the deepest dl of the conflict do not affect it, thus the value of the deepest one failed as a whole
+		DL level = conflictLevels.empty() ? 0 : *max_element(conflictLevels.begin(), conflictLevels.end());
+		if (level == 0)
+			return false;
+
+		auto& decision = decisions[level - 1];
+		solved = decision.solvedBefore + pow(0.5, level);
+		auto& failures = levelConflicts[level];
+		for (auto& failure : failures)
+			isLevelAdded[failure] = true;
+		for (auto& conflictLevel : conflictLevels)
+			if (conflictLevel != level && !isLevelAdded[conflictLevel])
+			{
+				isLevelAdded[conflictLevel] = true;
+				failures.push_back(conflictLevel);
+			}
+		for (auto& failure : failures)
+			isLevelAdded[failure] = false;
+
+		undo(decision.trailPosition);
+		decisions.resize(level);
+		guessPosition = decision.position;
+		if (decision.isFlipped)
+		{
+			//Both values failed, which depends on the lower dls of both failures
+			conflictLevels = failures;
+			continue;
+		}
+
+		decision.isFlipped = true;
+		decision.solvedBefore = solved;
+		assign(guessOrder[guessPosition], -guesses[guessPosition], guess);
+		if (propagate())
+			return true;
+		analyzeConflict(conflictLevels);
+	}
+}
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::analyzeConflict(vector<DL>& conflictLevels)
+{
+	//The reasons are traced back from the conflict to the guesses, skipping the assignments at dl 0
+	conflictLevels.clear();
+	analysisNumber++;
+	analysisStack.clear();
+	analysisStack.push_back(conflictArgument);
+	addAntecedents(conflictArgument, conflictReason, trail.size());
+	while (!analysisStack.empty())
+	{
+		auto argument = analysisStack.back();
+		analysisStack.pop_back();
+		if (levels[argument] == 0 || visitedInAnalysis[argument] == analysisNumber)
+			continue;
+
+		visitedInAnalysis[argument] = analysisNumber;
+		auto& reason = reasons[argument];
+		if (reason.type == ReasonType::Decision)
+			conflictLevels.push_back(levels[argument]);
+		else
+			addAntecedents(argument, reason, trailPositions[argument]);
+	}
+}
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::addAntecedents(ID const& argument, Reason const& reason, size_t const& trailPosition)
+{
+	//Of the arguments that block an attack, the one with the lowest dl is taken, such that the conflict depends on guesses as early as possible
+	auto addBlockedAttacks = [&](ID const& target)
+	{
+		for (auto i = attacksOnOffsets[target]; i < attacksOnOffsets[target + 1]; i++)
+		{
+			auto& attack = attacks[attacksOn[i]];
+			ID blocker = 0;
+			bool isBlocked = false;
+			for (unsigned char j = 0; j < attack.size; j++)
+			{
+				auto member = attack.support[j];
+				if (values[member] == -1 && trailPositions[member] < trailPosition && (!isBlocked || levels[member] < levels[blocker]))
+				{
+					blocker = member;
+					isBlocked = true;
+				}
+			}
+			if (isBlocked)
+				analysisStack.push_back(blocker);
+		}
+	};
+
+	switch (reason.type)
+	{
+		case ReasonType::LastMemberOut:
+		{
+			auto& attack = attacks[reason.source];
+			analysisStack.push_back(attack.target);
+			for (unsigned char i = 0; i < attack.size; i++)
+				if (attack.support[i] != argument)
+					analysisStack.push_back(attack.support[i]);
+			break;
+		}
+		case ReasonType::TargetOut:
+		{
+			auto& attack = attacks[reason.source];
+			for (unsigned char i = 0; i < attack.size; i++)
+				analysisStack.push_back(attack.support[i]);
+			break;
+		}
+		case ReasonType::Unattacked:
+			addBlockedAttacks(argument);
+			break;
+		case ReasonType::LiveAttackMemberIn:
+			//The only attack that is not blocked has no blocker
+			analysisStack.push_back(reason.source);
+			addBlockedAttacks(reason.source);
+			break;
+		default:
+			break;
+	}
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::assign(ID const& argument, Sign const& value, Reason const& reason)
+{
+	if (values[argument] != 0)
+		return values[argument] == value || setConflict(argument, reason);
+
+	values[argument] = value;
+	levels[argument] = decisions.size();
+	trailPositions[argument] = trail.size();
+	reasons[argument] = reason;
+	trail.push_back(argument);
+	for (auto i = supportedAttacksOffsets[argument]; i < supportedAttacksOffsets[argument + 1]; i++)
+	{
+		auto attack = supportedAttacks[i];
+		unassignedMembers[attack]--;
+		if (value == -1 && outMembers[attack]++ == 0)
+			liveAttacks[attacks[attack].target]--;
+	}
+	return true;
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::setConflict(ID const& argument, Reason const& reason)
+{
+	conflictArgument = argument;
+	conflictReason = reason;
+	return false;
+}
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::undo(size_t const& trailPosition)
+{
+	for (; trail.size() > trailPosition; trail.pop_back())
+	{
+		auto argument = trail.back();
+		for (auto i = supportedAttacksOffsets[argument]; i < supportedAttacksOffsets[argument + 1]; i++)
+		{
+			auto attack = supportedAttacks[i];
+			unassignedMembers[attack]++;
+			if (values[argument] == -1 && --outMembers[attack] == 0)
+				liveAttacks[attacks[attack].target]++;
+		}
+		values[argument] = 0;
+	}
+	propagationPosition = trailPosition;
+}
+
+template <size_t Arity>
+void FixedAritySolver<Arity>::assignLastMember(ID const& attack)
+{
+	Reason const reason = { ReasonType::LastMemberOut, attack };
+	auto& members = attacks[attack];
+	if constexpr (Arity == 1)
+		assign(members.support[0], -1, reason);
+	else
+	{
+		for (unsigned char i = 0; i < members.size; i++)
+			if (values[members.support[i]] == 0)
+			{
+				assign(members.support[i], -1, reason);
+				return;
+			}
+	}
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::assignLiveAttack(ID const& argument)
+{
+	Reason const reason = { ReasonType::LiveAttackMemberIn, argument };
+	for (auto i = attacksOnOffsets[argument]; i < attacksOnOffsets[argument + 1]; i++)
+	{
+		auto& attack = attacks[attacksOn[i]];
+		if (outMembers[attacksOn[i]] != 0)
+			continue;
+
+		for (unsigned char j = 0; j < attack.size; j++)
+			if (!assign(attack.support[j], 1, reason))
+				return false;
+		return true;
+	}
+	return true;
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::propagate()
+{
+	//The counters are updated on assignment, the rules are applied once an assignment is taken from the trail
+	for (; propagationPosition < trail.size(); propagationPosition++)
+	{
+		auto argument = trail[propagationPosition];
+		auto value = values[argument];
+
+		//An argument that is in requires every attack on it to be blocked, an argument that is out requires an attack on it with all supporting arguments in
+		if (value == 1)
+		{
+			for (auto i = attacksOnOffsets[argument]; i < attacksOnOffsets[argument + 1]; i++)
+			{
+				auto attack = attacksOn[i];
+				if (outMembers[attack] != 0)
+					continue;
+				if (unassignedMembers[attack] == 0)
+					return setConflict(argument, { ReasonType::TargetOut, attack });
+				if (unassignedMembers[attack] == 1)
+					assignLastMember(attack);
+			}
+		}
+		else if (liveAttacks[argument] == 0)
+			return setConflict(argument, { ReasonType::Unattacked, 0 });
+		else if (liveAttacks[argument] == 1 && !assignLiveAttack(argument))
+			return false;
+
+		//The attacks the argument supports
+		for (auto i = supportedAttacksOffsets[argument]; i < supportedAttacksOffsets[argument + 1]; i++)
+		{
+			auto attack = supportedAttacks[i];
+			auto target = attacks[attack].target;
+			if (value == 1)
+			{
+				if (outMembers[attack] != 0)
+					continue;
+				if (unassignedMembers[attack] == 0)
+				{
+					if (!assign(target, -1, { ReasonType::TargetOut, attack }))
+						return false;
+				}
+				else if (unassignedMembers[attack] == 1 && values[target] == 1)
+					assignLastMember(attack);
+			}
+			else if (liveAttacks[target] == 0)
+			{
+				if (!assign(target, 1, { ReasonType::Unattacked, 0 }))
+					return false;
+			}
+			else if (liveAttacks[target] == 1 && values[target] == -1 && !assignLiveAttack(target))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template <size_t Arity>
+bool FixedAritySolver<Arity>::printModel()
+{
+	//Record the first model time
+	if (modelCount == 0)
+		firstModelTime = chrono::high_resolution_clock::now();
+	modelCount++;
+
+	if (printModels)
+	{
+		modelArguments.clear();
+		for (ID i = 0; i < values.size(); i++)
+			if (values[i] == 1)
+				modelArguments.push_back(i);
+
+		if (reconstruction != nullptr)
+		{
+			reconstruction->reconstructModel(modelArguments, originalModelArguments);
+			modelSink.addModel(modelCount, originalModelArguments);
+		}
+		else
+			modelSink.addModel(modelCount, modelArguments);
+	}
+
+	return numberOfModels != 0 && modelCount >= numberOfModels;
+}
+
+template class FixedAritySolver<1>;
+template class FixedAritySolver<2>;
+template class FixedAritySolver<3>;
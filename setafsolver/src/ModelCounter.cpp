@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <cassert>
+
+#include "../header/ModelCounter.hpp"
+#include "../header/tools/Helper.hpp"
+
+size_t ModelCounter::SignatureHash::operator()(vector<ID> const& signature) const
+{
+	size_t hash = signature.size();
+	for (auto& value : signature)
+		hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+ModelCounter::ModelCounter(Instance& instance, size_t const& cacheLimit) :
+	instance(instance),
+	cacheLimit(cacheLimit),
+	attacksOn(instance.getNumberOfArguments()),
+	supportedAttacks(instance.getNumberOfArguments()),
+	values(instance.getNumberOfArguments(), 0),
+	outMembers(instance.getNumberOfAttacks(), 0),
+	liveAttacks(instance.getNumberOfArguments(), 0),
+	argumentVisited(instance.getNumberOfArguments(), 0),
+	constraintVisited(instance.getNumberOfArguments(), 0)
+{
+	supportOffsets.reserve(instance.getNumberOfAttacks() + 1);
+	attackTarget.reserve(instance.getNumberOfAttacks());
+	unassignedMembers.reserve(instance.getNumberOfAttacks());
+	supportOffsets.push_back(0);
+
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto attackId = attackTarget.size();
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto targetId = memberBegin->first->getId();
+		attackTarget.push_back(targetId);
+		attacksOn[targetId].push_back(attackId);
+
+		//The parser removes the attacked argument from the members of a self attack, but it is part of the support
+		if (begin->isSelfAttack())
+		{
+			supportMembers.push_back(targetId);
+			supportedAttacks[targetId].push_back(attackId);
+		}
+
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+		{
+			supportMembers.push_back(memberBegin->first->getId());
+			supportedAttacks[memberBegin->first->getId()].push_back(attackId);
+		}
+
+		supportOffsets.push_back(supportMembers.size());
+		unassignedMembers.push_back(supportOffsets[attackId + 1] - supportOffsets[attackId]);
+	}
+
+	for (ID i = 0; i < liveAttacks.size(); i++)
+		liveAttacks[i] = attacksOn[i].size();
+}
+
+BigUnsigned ModelCounter::count()
+{
+	//Arguments without attacks on them are in
+	for (ID i = 0; i < values.size(); i++)
+		if (attacksOn[i].empty())
+			assign(i, 1);
+
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end; begin++)
+		if (!assign(begin->first->getId(), begin->second))
+			return BigUnsigned(0);
+
+	if (!propagate())
+		return BigUnsigned(0);
+
+	vector<ID> unassigned;
+	for (ID i = 0; i < values.size(); i++)
+		if (values[i] == 0)
+			unassigned.push_back(i);
+
+	BigUnsigned result(1);
+	for (auto& component : computeComponents(unassigned))
+	{
+		result *= countComponent(std::move(component));
+		if (result.isZero())
+			break;
+	}
+
+	return result;
+}
+
+bool ModelCounter::assign(ID const& argument, Sign const& value)
+{
+	if (values[argument] != 0)
+		return values[argument] == value;
+
+	values[argument] = value;
+	trail.push_back(argument);
+	return true;
+}
+
+bool ModelCounter::propagate()
+{
+	//The counters only reflect the assignments up to propagationPosition. Assignments after it are treated as unassigned by the counters
+	while (propagationPosition < trail.size())
+	{
+		auto argument = trail[propagationPosition++];
+		auto value = values[argument];
+
+		//Update the counters first, such that undo can revert them completely if a conflict occurs
+		for (auto& attack : supportedAttacks[argument])
+		{
+			unassignedMembers[attack]--;
+			if (value == -1 && ++outMembers[attack] == 1)
+				liveAttacks[attackTarget[attack]]--;
+		}
+
+		//Propagate over the attacks the argument supports
+		for (auto& attack : supportedAttacks[argument])
+		{
+			auto target = attackTarget[attack];
+
+			if (value == -1)
+			{
+				if (outMembers[attack] != 1)
+					continue; //Has already been blocked before
+
+				if (liveAttacks[target] == 0)
+				{
+					//No attack can defeat the target anymore, thus it must be in
+					if (!assign(target, 1))
+						return false;
+				}
+				else if (liveAttacks[target] == 1 && values[target] == -1)
+				{
+					//The last attack that is not blocked must defeat the target
+					for (auto& otherAttack : attacksOn[target])
+						if (outMembers[otherAttack] == 0)
+						{
+							for (auto member = supportOffsets[otherAttack]; member < supportOffsets[otherAttack + 1]; member++)
+								if (!assign(supportMembers[member], 1))
+									return false;
+							break;
+						}
+				}
+			}
+			else
+			{
+				if (outMembers[attack] != 0)
+					continue; //Blocked attacks don't matter
+
+				if (unassignedMembers[attack] == 0)
+				{
+					//Every supporting argument is in, thus the target is defeated
+					if (!assign(target, -1))
+						return false;
+				}
+				else if (unassignedMembers[attack] == 1 && values[target] == 1)
+				{
+					//The target is in, thus the last supporting argument must be out. If it has been assigned but not propagated yet, its propagation takes care of it
+					for (auto member = supportOffsets[attack]; member < supportOffsets[attack + 1]; member++)
+						if (values[supportMembers[member]] == 0)
+						{
+							assign(supportMembers[member], -1);
+							break;
+						}
+				}
+			}
+		}
+
+		//Check the attacks on the argument itself
+		if (value == 1)
+		{
+			for (auto& attack : attacksOn[argument])
+			{
+				if (outMembers[attack] != 0)
+					continue;
+
+				//An argument that is in can't be defeated
+				if (unassignedMembers[attack] == 0)
+					return false;
+
+				if (unassignedMembers[attack] == 1)
+					for (auto member = supportOffsets[attack]; member < supportOffsets[attack + 1]; member++)
+						if (values[supportMembers[member]] == 0)
+						{
+							assign(supportMembers[member], -1);
+							break;
+						}
+			}
+		}
+		else
+		{
+			//An argument that is out must be defeated by some attack that is not blocked
+			if (liveAttacks[argument] == 0)
+				return false;
+
+			if (liveAttacks[argument] == 1)
+				for (auto& attack : attacksOn[argument])
+					if (outMembers[attack] == 0)
+					{
+						for (auto member = supportOffsets[attack]; member < supportOffsets[attack + 1]; member++)
+							if (!assign(supportMembers[member], 1))
+								return false;
+						break;
+					}
+		}
+	}
+
+	return true;
+}
+
+void ModelCounter::undo(size_t const& trailPosition)
+{
+	while (trail.size() > trailPosition)
+	{
+		auto argument = trail.back();
+
+		//Only propagated assignments have been counted
+		if (trail.size() <= propagationPosition)
+		{
+			for (auto& attack : supportedAttacks[argument])
+			{
+				unassignedMembers[attack]++;
+				if (values[argument] == -1 && --outMembers[attack] == 0)
+					liveAttacks[attackTarget[attack]]++;
+			}
+		}
+
+		values[argument] = 0;
+		trail.pop_back();
+	}
+
+	propagationPosition = min(propagationPosition, trailPosition);
+}
+
+bool ModelCounter::isConstraintOpen(ID const& argument) const
+{
+	switch (values[argument])
+	{
+		case 0:
+			return true;
+		case 1:
+			//Every attack on the argument must still be blocked by some unassigned argument
+			return liveAttacks[argument] != 0;
+		default:
+			//Closed iff some attack that is not blocked has all its supporting arguments in
+			for (auto& attack : attacksOn[argument])
+				if (outMembers[attack] == 0 && unassignedMembers[attack] == 0)
+					return false;
+			return true;
+	}
+}
+
+vector<vector<ID>> ModelCounter::computeComponents(vector<ID> const& arguments)
+{
+	vector<vector<ID>> components;
+	visitStamp++;
+
+	for (auto& start : arguments)
+	{
+		if (values[start] != 0 || argumentVisited[start] == visitStamp)
+			continue;
+
+		//Breadth first search over the unassigned arguments, connected via the constraints that are still open
+		auto& component = components.emplace_back();
+		argumentVisited[start] = visitStamp;
+		component.push_back(start);
+		for (size_t next = 0; next < component.size(); next++)
+		{
+			auto argument = component[next];
+
+			auto visitConstraint = [&](ID const& constraint)
+			{
+				if (constraintVisited[constraint] == visitStamp || !isConstraintOpen(constraint))
+					return;
+				constraintVisited[constraint] = visitStamp;
+
+				if (values[constraint] == 0 && argumentVisited[constraint] != visitStamp)
+				{
+					argumentVisited[constraint] = visitStamp;
+					component.push_back(constraint);
+				}
+
+				for (auto& attack : attacksOn[constraint])
+				{
+					if (outMembers[attack] != 0)
+						continue;
+					for (auto member = supportOffsets[attack]; member < supportOffsets[attack + 1]; member++)
+					{
+						auto memberId = supportMembers[member];
+						if (values[memberId] == 0 && argumentVisited[memberId] != visitStamp)
+						{
+							argumentVisited[memberId] = visitStamp;
+							component.push_back(memberId);
+						}
+					}
+				}
+			};
+
+			visitConstraint(argument);
+			for (auto& attack : supportedAttacks[argument])
+				if (outMembers[attack] == 0)
+					visitConstraint(attackTarget[attack]);
+		}
+
+		sort(component.begin(), component.end());
+	}
+
+	return components;
+}
+
+vector<ID> ModelCounter::computeSignature(vector<ID> const& arguments)
+{
+	//Collect the open constraints of the component
+	vector<ID> constraints;
+	visitStamp++;
+	for (auto& argument : arguments)
+	{
+		auto addConstraint = [&](ID const& constraint)
+		{
+			if (constraintVisited[constraint] != visitStamp && isConstraintOpen(constraint))
+			{
+				constraintVisited[constraint] = visitStamp;
+				constraints.push_back(constraint);
+			}
+		};
+
+		addConstraint(argument);
+		for (auto& attack : supportedAttacks[argument])
+			if (outMembers[attack] == 0)
+				addConstraint(attackTarget[attack]);
+	}
+	sort(constraints.begin(), constraints.end());
+
+	//The arguments, followed by each constraint with the value of its argument and the attacks on it that are not blocked
+	vector<ID> signature;
+	signature.reserve(arguments.size() + 3 * constraints.size() + 1);
+	signature.push_back(arguments.size());
+	signature.insert(signature.end(), arguments.begin(), arguments.end());
+	for (auto& constraint : constraints)
+	{
+		signature.push_back(constraint);
+		signature.push_back(values[constraint] + 1);
+		auto countIndex = signature.size();
+		signature.push_back(0);
+		for (auto& attack : attacksOn[constraint])
+			if (outMembers[attack] == 0)
+				signature.push_back(attack);
+		signature[countIndex] = signature.size() - countIndex - 1;
+	}
+
+	return signature;
+}
+
+bool ModelCounter::initializeFrame(Frame& frame, vector<ID>&& arguments, BigUnsigned& result)
+{
+	auto signature = computeSignature(arguments);
+	auto entry = cache.find(signature);
+	if (entry != cache.end())
+	{
+		result = entry->second;
+		return false;
+	}
+
+	//Guess the argument involved in the most attacks first
+	frame.branchArgument = *max_element(arguments.begin(), arguments.end(),
+		[&](ID const& first, ID const& second) { return attacksOn[first].size() + supportedAttacks[first].size() < attacksOn[second].size() + supportedAttacks[second].size(); });
+	frame.arguments = std::move(arguments);
+	frame.signature = std::move(signature);
+	frame.trailPosition = trail.size();
+	return true;
+}
+
+BigUnsigned ModelCounter::countComponent(vector<ID>&& arguments)
+{
+	BigUnsigned result;
+	vector<Frame> stack;
+	stack.emplace_back();
+	if (!initializeFrame(stack.back(), std::move(arguments), result))
+		return result;
+
+	while (true)
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		auto& frame = stack.back();
+
+		//Count the next subcomponent of the current branch, unless the product is already 0
+		if (frame.isBranchActive && frame.nextSubcomponent < frame.subcomponents.size() && !frame.product.isZero())
+		{
+			Frame child;
+			BigUnsigned cachedCount;
+			if (initializeFrame(child, std::move(frame.subcomponents[frame.nextSubcomponent++]), cachedCount))
+				stack.push_back(std::move(child));
+			else
+				frame.product *= cachedCount;
+			continue;
+		}
+
+		//The current branch is finished
+		if (frame.isBranchActive)
+		{
+			frame.total += frame.product;
+			frame.isBranchActive = false;
+			undo(frame.trailPosition);
+		}
+
+		//Start the next branch, in first
+		if (frame.startedBranches < 2)
+		{
+			assert(values[frame.branchArgument] == 0);
+			assign(frame.branchArgument, frame.startedBranches == 0 ? 1 : -1);
+			frame.startedBranches++;
+
+			if (propagate())
+			{
+				frame.subcomponents = computeComponents(frame.arguments);
+				frame.nextSubcomponent = 0;
+				frame.product = BigUnsigned(1);
+				frame.isBranchActive = true;
+			}
+			else
+				undo(frame.trailPosition);
+			continue;
+		}
+
+		//Both branches are finished
+		result = frame.total;
+		addToCache(std::move(frame.signature), frame.total);
+		stack.pop_back();
+		if (stack.empty())
+			return result;
+		stack.back().product *= result;
+	}
+}
+
+void ModelCounter::addToCache(vector<ID>&& signature, BigUnsigned const& count)
+{
+	//Rough estimate of the memory of an entry, including the node and the key in cacheOrder
+	auto entrySize = 2 * signature.size() * sizeof(ID) + 4 * sizeof(void*) + sizeof(BigUnsigned) + sizeof(vector<ID>);
+	if (entrySize > cacheLimit)
+		return;
+
+	cacheOrder.push_back(signature);
+	cache.emplace(std::move(signature), count);
+	cacheSize += entrySize;
+
+	//Evict the oldest entries
+	while (cacheSize > cacheLimit)
+	{
+		auto& oldest = cacheOrder.front();
+		cacheSize -= 2 * oldest.size() * sizeof(ID) + 4 * sizeof(void*) + sizeof(BigUnsigned) + sizeof(vector<ID>);
+		cache.erase(oldest);
+		cacheOrder.pop_front();
+	}
+}
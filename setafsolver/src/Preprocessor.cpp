@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <map>
+#include <iostream>
+#include <fmt/core.h>
+
+#include "../header/Preprocessor.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/tools/IDTrie.hpp"
+
+Preprocessor::Preprocessor(Instance& instance) : instance(instance) {};
+
+Instance Preprocessor::reduce()
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	vector<Attack> attacks;
+	attacks.reserve(instance.getNumberOfAttacks());
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto& [target, support] = attacks.emplace_back(memberBegin->first->getId(), vector<ID>());
+
+		//The parser removes the attacked argument from the members of a self attack, but it is part of the support
+		if (begin->isSelfAttack())
+			support.push_back(target);
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			support.push_back(memberBegin->first->getId());
+		sort(support.begin(), support.end());
+	}
+
+	computeGrounded(attacks);
+
+	//Remove the attacks that can't be part of any stable extension and the arguments of the grounded extension from the supports
+	vector<Attack> remainingAttacks;
+	for (auto& [target, support] : attacks)
+	{
+		if (groundedValues[target] != 0 || any_of(support.begin(), support.end(), [&](ID const& member) { return groundedValues[member] == -1; }))
+			continue;
+
+		support.erase(remove_if(support.begin(), support.end(), [&](ID const& member) { return groundedValues[member] == 1; }), support.end());
+		remainingAttacks.emplace_back(target, std::move(support));
+	}
+	attacks.swap(remainingAttacks);
+	collapseAttacks(attacks);
+
+	//Merging and collapsing repeat until nothing changes. The grounded reduction is not repeated: afterwards every remaining argument has an attack whose support only
+	//contains remaining arguments, and merging only renames supporting arguments while collapsing keeps a subset of every removed attack, thus the grounded extension
+	//of the reduced instance is empty
+	representatives.resize(numberOfArguments);
+	for (ID i = 0; i < numberOfArguments; i++)
+		representatives[i] = i;
+	while (mergeArguments(attacks))
+		Helper::throwExceptionIfReceivedSignal();
+
+	//Number the remaining arguments in their original order
+	const ID removed = numeric_limits<ID>::max();
+	vector<ID> reducedIds(numberOfArguments, removed);
+	for (ID i = 0; i < numberOfArguments; i++)
+	{
+		if (groundedValues[i] == 1)
+			groundedArguments.push_back(i);
+		else if (groundedValues[i] == 0 && representatives[i] == i)
+		{
+			reducedIds[i] = represented.size();
+			represented.emplace_back();
+		}
+
+		if (groundedValues[i] == 0)
+			represented[reducedIds[findRepresentative(i)]].push_back(i);
+	}
+
+	Instance reducedInstance(represented.size(), attacks.size());
+	for (ID i = 0; i < represented.size(); i++)
+		reducedInstance.getArgument(i).setName(instance.getArgument(represented[i][0]).getName());
+
+	for (ID i = 0; i < attacks.size(); i++)
+	{
+		auto& [target, support] = attacks[i];
+		auto& attack = reducedInstance.getAttack(i);
+		attack.setAttacked(reducedInstance.getArgument(reducedIds[target]), -1);
+		for (auto& member : support)
+		{
+			if (member == target)
+			{
+				attack.markAsSelfAttack();
+				continue;
+			}
+
+			auto& reducedMember = reducedInstance.getArgument(reducedIds[member]);
+			attack.addArgument(reducedMember, -1);
+
+			//Same initialization of the heuristics value as done by the parser
+			reducedMember.setHeuristicsValue(reducedMember.getHeuristicsValue() + 1.0);
+		}
+	}
+
+	//Required arguments are moved to their representatives. A requirement that contradicts the grounded extension leaves no extension
+	vector<Sign> requiredValues(represented.size(), 0);
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end; begin++)
+	{
+		auto& [argument, sign] = *begin;
+		auto id = argument->getId();
+		if (groundedValues[id] != 0)
+		{
+			hasConflict |= groundedValues[id] != sign;
+			continue;
+		}
+
+		auto representative = findRepresentative(id);
+		auto& requiredValue = requiredValues[reducedIds[representative]];
+		hasConflict |= requiredValue == -sign;
+		if (requiredValue == 0)
+		{
+			requiredValue = sign;
+			reducedInstance.addRequiredArgument(reducedInstance.getArgument(reducedIds[representative]), sign);
+		}
+	}
+
+	return reducedInstance;
+}
+
+void Preprocessor::computeGrounded(vector<Attack> const& attacks)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+	vector<vector<ID>> supportedAttacks(numberOfArguments);
+	vector<ID> unblockedAttacks(numberOfArguments, 0), missingMembers(attacks.size());
+	for (ID i = 0; i < attacks.size(); i++)
+	{
+		auto& [target, support] = attacks[i];
+		unblockedAttacks[target]++;
+		missingMembers[i] = support.size();
+		for (auto& member : support)
+			supportedAttacks[member].push_back(i);
+	}
+
+	//An argument is in once all attacks on it are blocked by a defeated argument and defeated once an attack on it has all its supporting arguments in
+	groundedValues.assign(numberOfArguments, 0);
+	vector<ID> queue;
+	for (ID i = 0; i < numberOfArguments; i++)
+		if (unblockedAttacks[i] == 0)
+		{
+			groundedValues[i] = 1;
+			queue.push_back(i);
+		}
+
+	vector<bool> isBlocked(attacks.size(), false);
+	for (size_t next = 0; next < queue.size(); next++)
+	{
+		auto argument = queue[next];
+		for (auto& attack : supportedAttacks[argument])
+		{
+			auto target = attacks[attack].first;
+			if (groundedValues[argument] == 1)
+			{
+				if (--missingMembers[attack] == 0 && groundedValues[target] == 0)
+				{
+					groundedValues[target] = -1;
+					queue.push_back(target);
+				}
+			}
+			else if (!isBlocked[attack])
+			{
+				isBlocked[attack] = true;
+				if (--unblockedAttacks[target] == 0 && groundedValues[target] == 0)
+				{
+					groundedValues[target] = 1;
+					queue.push_back(target);
+				}
+			}
+		}
+	}
+}
+
+bool Preprocessor::mergeArguments(vector<Attack>& attacks)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+	vector<vector<ID>> attacksOn(numberOfArguments);
+	for (ID i = 0; i < attacks.size(); i++)
+		attacksOn[attacks[i].first].push_back(i);
+
+	//The signature of an argument consists of the sorted supports of all attacks on it, each preceded by its size
+	map<vector<ID>, ID> argumentBySignature;
+	vector<ID> signature;
+	bool hasMerged = false;
+	for (ID i = 0; i < numberOfArguments; i++)
+	{
+		if (groundedValues[i] != 0 || representatives[i] != i)
+			continue;
+
+		vector<vector<ID> const*> supports;
+		for (auto& attack : attacksOn[i])
+			supports.push_back(&attacks[attack].second);
+		if (any_of(supports.begin(), supports.end(), [&](vector<ID> const* support) { return binary_search(support->begin(), support->end(), i); }))
+			continue;
+
+		sort(supports.begin(), supports.end(), [](vector<ID> const* first, vector<ID> const* second) { return *first < *second; });
+		signature.clear();
+		for (auto& support : supports)
+		{
+			signature.push_back(support->size());
+			signature.insert(signature.end(), support->begin(), support->end());
+		}
+
+		auto [entry, isInserted] = argumentBySignature.try_emplace(signature, i);
+		if (!isInserted)
+		{
+			representatives[i] = entry->second;
+			numberOfMergedArguments++;
+			hasMerged = true;
+		}
+	}
+
+	if (!hasMerged)
+		return false;
+
+	//The supports only contain representatives of previous rounds, which are not merged in the same round as others are merged into them.
+	//The attacks on merged arguments are identical to those on their representatives and are removed
+	vector<Attack> remainingAttacks;
+	for (auto& [target, support] : attacks)
+	{
+		if (representatives[target] != target)
+			continue;
+
+		for (auto& member : support)
+			member = representatives[member];
+		sort(support.begin(), support.end());
+		support.erase(unique(support.begin(), support.end()), support.end());
+		remainingAttacks.emplace_back(target, std::move(support));
+	}
+	attacks.swap(remainingAttacks);
+	collapseAttacks(attacks);
+
+	return true;
+}
+
+void Preprocessor::collapseAttacks(vector<Attack>& attacks)
+{
+	//Same as the subsumption check of the parser, sorting by size ensures that an attack can't be a proper subset of a previous one
+	stable_sort(attacks.begin(), attacks.end(), [](Attack const& first, Attack const& second) { return first.second.size() < second.second.size(); });
+
+	IDTrie trie;
+	vector<Attack> remainingAttacks;
+	for (auto& [target, support] : attacks)
+	{
+		if (trie.containsSubsetOf(target, support))
+		{
+			numberOfCollapsedAttacks++;
+			continue;
+		}
+
+		trie.insert(target, support);
+		remainingAttacks.emplace_back(target, std::move(support));
+	}
+	attacks.swap(remainingAttacks);
+}
+
+ID Preprocessor::findRepresentative(ID argument) const
+{
+	while (representatives[argument] != argument)
+		argument = representatives[argument];
+	return argument;
+}
+
+bool Preprocessor::isInconsistent() const
+{
+	return hasConflict;
+}
+
+void Preprocessor::printReport(Instance& reducedInstance) const
+{
+	auto numberOfDefeated = count(groundedValues.begin(), groundedValues.end(), -1);
+	cout << fmt::format("Preprocessing: {} of {} arguments and {} of {} attacks remain ({} grounded in, {} grounded out, {} merged, {} attacks collapsed)",
+		reducedInstance.getNumberOfArguments(), instance.getNumberOfArguments(), reducedInstance.getNumberOfAttacks(), instance.getNumberOfAttacks(),
+		groundedArguments.size(), numberOfDefeated, numberOfMergedArguments, numberOfCollapsedAttacks) << endl;
+}
+
+void Preprocessor::reconstructModel(vector<ID> const& inArguments, vector<ID>& originalArguments) const
+{
+	originalArguments.assign(groundedArguments.begin(), groundedArguments.end());
+	for (auto& argument : inArguments)
+		originalArguments.insert(originalArguments.end(), represented[argument].begin(), represented[argument].end());
+	sort(originalArguments.begin(), originalArguments.end());
+}
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <cassert>
+
+#include "../header/TreeDecompositionSolver.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/Preprocessor.hpp"
+
+TreeDecompositionSolver::TreeDecompositionSolver(Instance& instance, TreeDecomposition const& decomposition, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, optional<BigUnsigned>& exactModelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, size_t const& memoryLimit) :
+	instance(instance),
+	decomposition(decomposition),
+	firstModelTime(firstModelTime),
+	modelCount(modelCount),
+	exactModelCount(exactModelCount),
+	percentageSolved(percentageSolved),
+	numberOfModels(numberOfModels),
+	modelSink(modelSink),
+	printModels(modelSink.requiresModels()),
+	memoryLimit(memoryLimit)
+{
+	assert(decomposition.getWidth() <= maximumWidth);
+};
+
+bool TreeDecompositionSolver::solve()
+{
+	initialize();
+
+	//The children of a bag always precede it
+	auto numberOfBags = decomposition.getNumberOfBags();
+	messages.resize(numberOfBags);
+	if (printModels)
+		levels.resize(numberOfBags);
+	for (size_t i = 0; i < numberOfBags; i++)
+		if (!computeTables(i))
+			return false;
+
+	//The roots have empty messages, their counts are multiplied
+	BigUnsigned count(hasConflictingRequirements ? 0 : 1);
+	for (size_t i = 0; i < numberOfBags && !count.isZero(); i++)
+		if (decomposition.getParent(i) == TreeDecomposition::noParent)
+		{
+			auto index = messages[i].find(0, 0);
+			if (!index)
+				count = BigUnsigned(0);
+			else
+				count *= messages[i].counts[*index];
+		}
+
+	if (printModels && !count.isZero())
+	{
+		enumerate(count);
+		return true;
+	}
+
+	percentageSolved = 1.0;
+	if (numberOfModels != 0 && BigUnsigned(numberOfModels) < count)
+		count = BigUnsigned(numberOfModels);
+	modelCount = count.toULongSaturated();
+	if (modelCount != 0)
+		firstModelTime = chrono::high_resolution_clock::now();
+	exactModelCount = count;
+	return true;
+}
+
+void TreeDecompositionSolver::setReconstruction(Preprocessor const* reconstruction)
+{
+	this->reconstruction = reconstruction;
+}
+
+void TreeDecompositionSolver::initialize()
+{
+	auto numberOfBags = decomposition.getNumberOfBags();
+	vector<size_t> eliminationPositions(instance.getNumberOfArguments());
+	for (size_t i = 0; i < numberOfBags; i++)
+		eliminationPositions[decomposition.getBag(i)[0]] = i;
+
+	auto positionInBag = [&](size_t const& bag, ID const& argument)
+	{
+		auto& members = decomposition.getBag(bag);
+		return (unsigned char)(find(members.begin(), members.end(), argument) - members.begin());
+	};
+
+	//Every attack is a clique in the primal graph, thus the bag of its argument eliminated first contains all of its arguments
+	localAttacks.resize(numberOfBags);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto bag = eliminationPositions[memberBegin->first->getId()];
+		for (auto member = memberBegin + 1; member != memberEnd; member++)
+			bag = min(bag, eliminationPositions[member->first->getId()]);
+
+		//The parser removes the attacked argument from the members of a self attack, but it is part of the support
+		auto target = positionInBag(bag, memberBegin->first->getId());
+		uint32_t support = begin->isSelfAttack() ? 1u << target : 0;
+		for (auto member = memberBegin + 1; member != memberEnd; member++)
+			support |= 1u << positionInBag(bag, member->first->getId());
+
+		localAttacks[bag].emplace_back(support, target);
+	}
+
+	positionsInParent.resize(numberOfBags);
+	for (size_t i = 0; i < numberOfBags; i++)
+	{
+		auto parent = decomposition.getParent(i);
+		if (parent == TreeDecomposition::noParent)
+			continue;
+
+		auto& bag = decomposition.getBag(i);
+		for (auto member = bag.begin() + 1; member != bag.end(); member++)
+			positionsInParent[i].push_back(positionInBag(parent, *member));
+	}
+
+	requiredValues.resize(instance.getNumberOfArguments(), 0);
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end; begin++)
+	{
+		auto& [argument, sign] = *begin;
+		if (requiredValues[argument->getId()] == -sign)
+			hasConflictingRequirements = true;
+		requiredValues[argument->getId()] = sign;
+	}
+}
+
+bool TreeDecompositionSolver::computeTables(size_t const& bag)
+{
+	Helper::throwExceptionIfReceivedSignal();
+
+	auto& members = decomposition.getBag(bag);
+	auto required = requiredValues[members[0]];
+
+	//The local table contains every assignment of the bag that respects the attacks handled here. The defeated arguments follow from the assignment
+	vector<pair<uint64_t, BigUnsigned>> states;
+	vector<Table> bagLevels(1);
+	for (uint64_t assignment = 0; assignment < (1ull << members.size()); assignment++)
+	{
+		uint32_t in = assignment;
+		if ((required == 1 && !(in & 1)) || (required == -1 && (in & 1)))
+			continue;
+
+		uint32_t defeated = 0;
+		bool isConflicting = false;
+		for (auto& [support, target] : localAttacks[bag])
+			if ((in & support) == support)
+			{
+				if (in & (1u << target))
+				{
+					isConflicting = true;
+					break;
+				}
+				defeated |= 1u << target;
+			}
+
+		if (isConflicting)
+			continue;
+		if (!fitsMemory(states.size() + 1))
+			return false;
+		states.emplace_back(pack(in, defeated), BigUnsigned(1));
+	}
+	if (!buildTable(states, members.size(), bagLevels[0]))
+		return false;
+	tableMemory += bagLevels[0].getMemory();
+
+	//Join the messages of the children one after another. An argument is defeated if it is defeated on either side
+	for (auto& child : decomposition.getChildren(bag))
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		auto& message = messages[child];
+		auto& positions = positionsInParent[child];
+		auto& previous = bagLevels.back();
+		for (size_t in = 0; in + 1 < previous.offsets.size(); in++)
+		{
+			if (previous.offsets[in] == previous.offsets[in + 1])
+				continue;
+
+			auto childIn = gather(in, positions);
+			for (auto i = previous.offsets[in]; i < previous.offsets[in + 1]; i++)
+				for (auto j = message.offsets[childIn]; j < message.offsets[childIn + 1]; j++)
+				{
+					if (!fitsMemory(states.size() + 1))
+						return false;
+
+					auto product = previous.counts[i];
+					product *= message.counts[j];
+					states.emplace_back(pack(in, previous.defeated[i] | scatter(message.defeated[j], positions)), std::move(product));
+				}
+		}
+
+		Table joined;
+		if (!buildTable(states, members.size(), joined))
+			return false;
+
+		//The message is only needed again for the enumeration
+		tableMemory += joined.getMemory();
+		if (printModels)
+			bagLevels.push_back(std::move(joined));
+		else
+		{
+			tableMemory -= message.getMemory() + previous.getMemory();
+			message = Table();
+			previous = std::move(joined);
+		}
+	}
+
+	//Forget the argument of the bag, which must be in or defeated by now, as all attacks on it are handled in this bag or below
+	auto& last = bagLevels.back();
+	for (size_t in = 0; in + 1 < last.offsets.size(); in++)
+		for (auto i = last.offsets[in]; i < last.offsets[in + 1]; i++)
+			if ((in & 1) || (last.defeated[i] & 1))
+			{
+				if (!fitsMemory(states.size() + 1))
+					return false;
+				states.emplace_back(pack(in >> 1, last.defeated[i] >> 1), last.counts[i]);
+			}
+
+	auto& result = messages[bag];
+	if (!buildTable(states, members.size() - 1, result))
+		return false;
+	tableMemory += result.getMemory();
+
+	if (printModels)
+		levels[bag] = std::move(bagLevels);
+	else
+		tableMemory -= last.getMemory();
+	return true;
+}
+
+bool TreeDecompositionSolver::fitsMemory(size_t const& numberOfStates) const
+{
+	return tableMemory + 2 * numberOfStates * stateMemory <= memoryLimit;
+}
+
+bool TreeDecompositionSolver::buildTable(vector<pair<uint64_t, BigUnsigned>>& states, size_t const& numberOfBits, Table& table)
+{
+	auto numberOfGroups = (size_t)1 << numberOfBits;
+	if (tableMemory + (numberOfGroups + 1) * sizeof(uint32_t) + 2 * states.size() * stateMemory > memoryLimit)
+		return false;
+
+	//The packed states order by the arguments in first, thus sorting them groups them
+	sort(states.begin(), states.end(), [](pair<uint64_t, BigUnsigned> const& first, pair<uint64_t, BigUnsigned> const& second) { return first.first < second.first; });
+	table.offsets.assign(numberOfGroups + 1, 0);
+	table.defeated.clear();
+	table.counts.clear();
+	for (size_t i = 0; i < states.size(); i++)
+	{
+		if (i != 0 && states[i].first == states[i - 1].first)
+		{
+			table.counts.back() += states[i].second;
+			continue;
+		}
+
+		table.offsets[(states[i].first >> 32) + 1]++;
+		table.defeated.push_back((uint32_t)states[i].first);
+		table.counts.push_back(std::move(states[i].second));
+	}
+
+	for (size_t i = 0; i < numberOfGroups; i++)
+		table.offsets[i + 1] += table.offsets[i];
+	states.clear();
+	return true;
+}
+
+optional<size_t> TreeDecompositionSolver::Table::find(uint32_t const& in, uint32_t const& defeatedMask) const
+{
+	auto begin = defeated.begin() + offsets[in], end = defeated.begin() + offsets[in + 1];
+	auto position = lower_bound(begin, end, defeatedMask);
+	if (position == end || *position != defeatedMask)
+		return {};
+	return position - defeated.begin();
+}
+
+size_t TreeDecompositionSolver::Table::getMemory() const
+{
+	return offsets.size() * sizeof(uint32_t) + defeated.size() * stateMemory;
+}
+
+void TreeDecompositionSolver::enumerate(BigUnsigned const& count)
+{
+	values.resize(instance.getNumberOfArguments(), 0);
+	auto total = count.toDouble();
+
+	//Depth first search over the alternatives of the tasks. Every alternative leads to at least one extension, as the tables only contain states with a positive count.
+	//The log records the changes of the pending tasks, such that they can be restored when returning to a choice point
+	vector<Task> pending;
+	vector<pair<bool, Task>> log;
+	vector<ChoicePoint> choicePoints;
+	for (size_t i = 0; i < decomposition.getNumberOfBags(); i++)
+		if (decomposition.getParent(i) == TreeDecomposition::noParent)
+			pending.push_back({ i, messageLevel, 0, 0 });
+
+	auto apply = [&](Alternative const& alternative)
+	{
+		if (alternative.assignment)
+			values[alternative.assignment->first] = alternative.assignment->second;
+		for (auto& task : alternative.tasks)
+		{
+			pending.push_back(task);
+			log.emplace_back(true, task);
+		}
+	};
+
+	while (true)
+	{
+		if (pending.empty())
+		{
+			printModel();
+			percentageSolved = modelCount / total;
+			if (numberOfModels == modelCount || Helper::receivedSignal())
+				return;
+
+			//Return to the last choice point with remaining alternatives
+			while (!choicePoints.empty() && choicePoints.back().next == choicePoints.back().alternatives.size())
+				choicePoints.pop_back();
+			if (choicePoints.empty())
+				return; //All extensions printed
+
+			auto& choicePoint = choicePoints.back();
+			for (; log.size() > choicePoint.logPosition; log.pop_back())
+			{
+				if (log.back().first)
+					pending.pop_back();
+				else
+					pending.push_back(log.back().second);
+			}
+			apply(choicePoint.alternatives[choicePoint.next++]);
+			continue;
+		}
+
+		auto task = pending.back();
+		pending.pop_back();
+		log.emplace_back(false, task);
+		if (task.level == 0)
+			continue; //The local table follows from the assignment
+
+		auto alternatives = computeAlternatives(task);
+		assert(!alternatives.empty());
+		if (alternatives.size() == 1)
+			apply(alternatives[0]);
+		else
+		{
+			choicePoints.push_back({ log.size(), std::move(alternatives), 1 });
+			apply(choicePoints.back().alternatives[0]);
+		}
+	}
+}
+
+vector<TreeDecompositionSolver::Alternative> TreeDecompositionSolver::computeAlternatives(Task const& task) const
+{
+	vector<Alternative> alternatives;
+	auto& bagLevels = levels[task.bag];
+
+	if (task.level == messageLevel)
+	{
+		//The argument of the bag is either in or out and defeated
+		auto argument = decomposition.getBag(task.bag)[0];
+		auto lastLevel = bagLevels.size() - 1;
+		for (Sign value : { 1, -1 })
+		{
+			uint32_t in = (task.in << 1) | (value == 1 ? 1 : 0);
+			uint32_t defeated = (task.defeated << 1) | (value == -1 ? 1 : 0);
+			if (bagLevels[lastLevel].find(in, defeated))
+				alternatives.push_back({ pair(argument, value), { { task.bag, lastLevel, in, defeated } } });
+		}
+		return alternatives;
+	}
+
+	//Split the state into a state of the previous level and a state of the child, such that the defeated arguments of both make up the defeated arguments of the state
+	auto child = decomposition.getChildren(task.bag)[task.level - 1];
+	auto& positions = positionsInParent[child];
+	auto childIn = gather(task.in, positions);
+	auto& message = messages[child];
+	auto& previousLevel = bagLevels[task.level - 1];
+	for (auto i = message.offsets[childIn]; i < message.offsets[childIn + 1]; i++)
+	{
+		auto childDefeated = message.defeated[i];
+		auto mappedDefeated = scatter(childDefeated, positions);
+		if (mappedDefeated & ~task.defeated)
+			continue;
+
+		//The arguments defeated by the child may or may not be defeated by the previous level as well
+		auto remaining = task.defeated & ~mappedDefeated;
+		for (uint32_t subset = mappedDefeated;; subset = (subset - 1) & mappedDefeated)
+		{
+			if (previousLevel.find(task.in, remaining | subset))
+				alternatives.push_back({ {}, { { task.bag, task.level - 1, task.in, remaining | subset }, { child, messageLevel, childIn, childDefeated } } });
+			if (subset == 0)
+				break;
+		}
+	}
+
+	return alternatives;
+}
+
+void TreeDecompositionSolver::printModel()
+{
+	//Record the first model time
+	if (modelCount == 0)
+		firstModelTime = chrono::high_resolution_clock::now();
+	modelCount++;
+
+	modelArguments.clear();
+	for (ID i = 0; i < values.size(); i++)
+		if (values[i] == 1)
+			modelArguments.push_back(i);
+
+	if (reconstruction != nullptr)
+	{
+		reconstruction->reconstructModel(modelArguments, originalModelArguments);
+		modelSink.addModel(modelCount, originalModelArguments);
+	}
+	else
+		modelSink.addModel(modelCount, modelArguments);
+}
+
+uint64_t TreeDecompositionSolver::pack(uint32_t const& in, uint32_t const& defeated)
+{
+	return ((uint64_t)in << 32) | defeated;
+}
+
+uint32_t TreeDecompositionSolver::gather(uint32_t const& mask, vector<unsigned char> const& positions)
+{
+	uint32_t result = 0;
+	for (size_t i = 0; i < positions.size(); i++)
+		result |= ((mask >> positions[i]) & 1u) << i;
+	return result;
+}
+
+uint32_t TreeDecompositionSolver::scatter(uint32_t const& mask, vector<unsigned char> const& positions)
+{
+	uint32_t result = 0;
+	for (size_t i = 0; i < positions.size(); i++)
+		result |= ((mask >> i) & 1u) << positions[i];
+	return result;
+}
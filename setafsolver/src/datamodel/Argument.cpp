@@ -7,27 +7,39 @@
 #include <iostream>
 #include <cassert>
 #include <tuple>
+#include <algorithm>
 
 using namespace std;
 
-Argument::Argument(ID const& id, ID const& position, string const& name) : id(id), position(position), name(name) {};
-Argument::Argument(ID const& id, ID const& position) : id(id), position(position), name(std::to_string(id + 1)) {};
-Argument::Argument(ID const& id) : id(id), position(id), name(std::to_string(id + 1)) {};
+Argument::Argument(ID const& id, ID const& position, string const& name) : id(id), position(position), name(name), number(id + 1) {};
+Argument::Argument(ID const& id, ID const& position) : id(id), position(position), name(std::to_string(id + 1)), number(id + 1) {};
+Argument::Argument(ID const& id) : id(id), position(id), name(std::to_string(id + 1)), number(id + 1) {};
 
 void Argument::setName(string const& name)
 {
 	this->name = name;
 }
 
-string Argument::getName() const
+string const& Argument::getName() const
 {
 	return name;
 }
 
+void Argument::setNumber(ID const& number)
+{
+	this->number = number;
+}
+
+ID Argument::getNumber() const
+{
+	return number;
+}
+
 void Argument::setIdAndPosition(ID const& id)
 {
 	this->id = id;
 	this->name = std::to_string(id + 1);
+	this->number = id + 1;
 	this->setPosition(id);
 }
 
@@ -80,7 +92,7 @@ void Argument::setValue(Sign const& value, DL const& dl, Clause* reason, Instanc
 	this->value = value;
 	this->dl = dl;
 	if (this->reason != nullptr && this->reason->decrementUseCounter())
-		instance.recycleClause(*reason);
+		instance.recycleClause(*this->reason);
 	
 	this->reason = reason;
 	if (reason != nullptr)
@@ -165,12 +177,8 @@ void Argument::setWatchedAttackedIndex(Clause& clause, size_t const& index)
 	watchedInAttackIndex = index;
 
 	auto [begin, end] = clause.getMembersIterator();	
-	begin++; //Skip first (= attacked argument, i.e. this)
-	for (auto& member = begin; begin != end; begin++)
-	{		
-		auto& [argument, sign] = *member;
-		argument->stabilityWatchPush(*this, index);
-	}
+	for (size_t position = 1; position < clause.getMemberCount(); position++) //Skip first (= attacked argument, i.e. this)
+		begin[position].first->stabilityWatchPush(*this, index, position);
 }
 
 size_t Argument::getWatchedAttackIndex() const
@@ -195,18 +203,40 @@ bool Argument::stabilityWatchIsEmpty() const
 	return stabilityWatch.empty();
 }
 
-pair<Argument&, size_t> Argument::stabilityWatchPop()
+tuple<Argument&, size_t, size_t> Argument::stabilityWatchPop()
 {
 	assert(!stabilityWatch.empty());
-	auto& [argument, index] = stabilityWatch.back();
-	auto returnValue = pair<Argument&, size_t>(*argument, index);
+	auto& [argument, index, position] = stabilityWatch.back();
+	auto returnValue = tuple<Argument&, size_t, size_t>(*argument, index, position);
+	argument->getAttackingClause(index).setStabilityWatchedBy(position, false);
 	stabilityWatch.pop_back();
+	stabilityWatchEntryCount--;
 	return returnValue;
 }
 
-void Argument::stabilityWatchPush(Argument& argument, size_t const& index)
+void Argument::stabilityWatchPush(Argument& argument, size_t const& index, size_t const& position)
+{
+	//An attack that is already contained is either still the witness or a stale entry that will be dropped, which is checked for the current witness anyway
+	auto& attack = argument.getAttackingClause(index);
+	if (attack.isStabilityWatchedBy(position))
+		return;
+
+	attack.setStabilityWatchedBy(position, true);
+	stabilityWatch.emplace_back(&argument, index, position);
+	stabilityWatchPeakEntryCount = max(stabilityWatchPeakEntryCount, ++stabilityWatchEntryCount);
+}
+
+void Argument::clearStabilityWatch()
+{
+	for (auto& [argument, index, position] : stabilityWatch)
+		argument->getAttackingClause(index).setStabilityWatchedBy(position, false);
+	stabilityWatchEntryCount -= stabilityWatch.size();
+	stabilityWatch.clear();
+}
+
+size_t Argument::getStabilityWatchPeakMemory()
 {
-	stabilityWatch.emplace_back(&argument, index);
+	return stabilityWatchPeakEntryCount * sizeof(decltype(stabilityWatch)::value_type);
 }
 
 Clause* Argument::getReason()
@@ -14,6 +14,7 @@ void Clause::reset(ClauseType const& clauseType)
 	firstWatch = 0;
 	secondWatch = 0;
 	this->clauseType = clauseType;
+	proofId = 0;
 	members.clear();
 }
 
@@ -32,6 +33,16 @@ ID Clause::getId() const
 	return id;
 }
 
+void Clause::setProofId(ID const& proofId)
+{
+	this->proofId = proofId;
+}
+
+ID Clause::getProofId() const
+{
+	return proofId;
+}
+
 void Clause::setAttacked(Argument& argument, Sign const& sign)
 {
 	assert(members.size() == 0);	
@@ -58,6 +69,11 @@ void Clause::addArgument(Argument& argument, Sign const& sign)
 	members.emplace_back(&argument, sign);
 }
 
+void Clause::addUnwatchedArgument(Argument& argument, Sign const& sign)
+{
+	members.emplace_back(&argument, sign);
+}
+
 pair<vector<pair<Argument*, Sign>>::iterator, vector<pair<Argument*, Sign>>::iterator> Clause::getMembersIterator()
 {
 	assert(members.size() > 0);
@@ -186,6 +202,20 @@ bool Clause::setWatch(bool const& isFirst, size_t const& index)
 	return true;
 }
 
+bool Clause::isStabilityWatchedBy(size_t const& index) const
+{
+	assert(index < members.size());
+	return index < stabilityWatchedMembers.size() && stabilityWatchedMembers[index];
+}
+
+void Clause::setStabilityWatchedBy(size_t const& index, bool const& isWatched)
+{
+	assert(index < members.size());
+	if (stabilityWatchedMembers.size() != members.size())
+		stabilityWatchedMembers.resize(members.size(), false);
+	stabilityWatchedMembers[index] = isWatched;
+}
+
 bool Clause::watchesAreInvalidArgSet(DL const& dl) const
 {
 	auto& [firstWatchedArgument, firstSign] = members[firstWatch];
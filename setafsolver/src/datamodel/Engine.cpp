@@ -0,0 +1,39 @@
+#include <string>
+#include "../../header/datamodel/Engine.hpp"
+using namespace std;
+
+
+Engine::Engine(EngineType const& type) : type(type) {};
+Engine::Engine() : Engine(EngineType::Auto) {};
+
+
+Engine::EngineType const& Engine::getType() const
+{
+	return type;
+}
+
+optional<Engine> Engine::tryParse(char* const& s)
+{
+	static string engineTypeAutoString = "Auto";
+	static string engineTypeEnumerationString = "Enumeration";
+	static string engineTypeCountingString = "Counting";
+	static string engineTypeTreeDecompositionString = "TreeDecomposition";
+	static string engineTypeFixedArityString = "FixedArity";
+
+	if (!engineTypeAutoString.compare(s))
+		return Engine(EngineType::Auto);
+
+	if (!engineTypeEnumerationString.compare(s))
+		return Engine(EngineType::Enumeration);
+
+	if (!engineTypeCountingString.compare(s))
+		return Engine(EngineType::Counting);
+
+	if (!engineTypeTreeDecompositionString.compare(s))
+		return Engine(EngineType::TreeDecomposition);
+
+	if (!engineTypeFixedArityString.compare(s))
+		return Engine(EngineType::FixedArity);
+
+	return {};
+}
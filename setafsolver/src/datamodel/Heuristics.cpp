@@ -1,7 +1,9 @@
 #include "../../header/datamodel/Heuristics.hpp"
 #include "../../header/tools/Helper.hpp"
+#include "../../header/tools/SparseMatrix.hpp"
 #include <optional>
 #include <algorithm>
+#include <cstring>
 #include <cmath>
 
 using namespace std;
@@ -17,6 +19,8 @@ optional<Heuristics> Heuristics::tryParse(char const* const s)
 	static string heuristicTypeMaxInDegreeString("MinInDegree");
 	static string heuristicTypePathLengtPrefixString("PathLength");
 	static string heuristicTypePathLengtModifiedPrefixString("PathLengthModified");
+	static string heuristicTypePageRankPrefixString("PageRank");
+	static string heuristicTypeEigenvectorPrefixString("EigenvectorCentrality");
 
 	if (!heuristicTypeNoneString.compare(s))
 	{
@@ -33,7 +37,19 @@ optional<Heuristics> Heuristics::tryParse(char const* const s)
 		return Heuristics(HeuristicTypes::MinInDegree);
 	}			
 	
-	if (heuristicTypePathLengtPrefixString.compare(0, heuristicTypePathLengtPrefixString.length(), s))
+	//Check the longer prefix first, as PathLength is a prefix of PathLengthModified
+	if (!strncmp(s, heuristicTypePathLengtModifiedPrefixString.c_str(), heuristicTypePathLengtModifiedPrefixString.length()))
+	{
+		optional<unsigned short> param = Helper::tryParseUShort(s + heuristicTypePathLengtModifiedPrefixString.size());
+		if (param)
+		{
+			Heuristics h(HeuristicTypes::PathLengthModified);
+			h.heuristicsParameter1 = *param;
+			return h;
+		}
+	}
+
+	if (!strncmp(s, heuristicTypePathLengtPrefixString.c_str(), heuristicTypePathLengtPrefixString.length()))
 	{		
 		optional<unsigned short> param = Helper::tryParseUShort(s + heuristicTypePathLengtPrefixString.size());
 		if (param)
@@ -44,26 +60,51 @@ optional<Heuristics> Heuristics::tryParse(char const* const s)
 		}
 	}
 
-	if (heuristicTypePathLengtModifiedPrefixString.compare(0, heuristicTypePathLengtModifiedPrefixString.length(), s))
+	//The centrality heuristics take an optional iteration cap and an optional tolerance, i.e. PageRank[N[:TOLERANCE]]
+	for (auto& [prefix, centralityType] : { pair(&heuristicTypePageRankPrefixString, HeuristicTypes::PageRank), pair(&heuristicTypeEigenvectorPrefixString, HeuristicTypes::EigenvectorCentrality) })
 	{
-		optional<unsigned short> param = Helper::tryParseUShort(s + heuristicTypePathLengtModifiedPrefixString.size());
-		if (param)
-		{
-			Heuristics h(HeuristicTypes::PathLengthModified);
-			h.heuristicsParameter1 = *param;
+		if (strncmp(s, prefix->c_str(), prefix->length()))
+			continue;
+
+		Heuristics h(centralityType);
+		h.heuristicsParameter1 = defaultMaximumIterations;
+		h.heuristicsParameter2 = defaultTolerance;
+
+		string parameters(s + prefix->length());
+		if (parameters.empty())
 			return h;
+
+		auto separatorIndex = parameters.find(':');
+		optional<unsigned short> maximumIterations = Helper::tryParseUShort(parameters.substr(0, separatorIndex));
+		if (!maximumIterations)
+			return {};
+		h.heuristicsParameter1 = *maximumIterations;
+
+		if (separatorIndex != string::npos)
+		{
+			optional<double> tolerance = Helper::tryParseDouble(parameters.substr(separatorIndex + 1));
+			if (!tolerance || *tolerance < 0)
+				return {};
+			h.heuristicsParameter2 = *tolerance;
 		}
+		return h;
 	}
 	
 	return {};
 }
 
 /**
- * {@return a vector that, for each argument, returns all arguments that are involved in some attack directed at the original argument}
+ * {@return a matrix that, for each argument, contains all arguments that are involved in some attack directed at the original argument}
  */
-vector<vector<Argument*>> computeAttackedBy(Instance& instance)
+SparseMatrix computeAttackedBy(Instance& instance)
 {
-	vector<vector<Argument*>> returnValue(instance.getNumberOfArguments());	
+	//First pass: count the entries of each row
+	vector<size_t> rowSizes(instance.getNumberOfArguments(), 0);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+		rowSizes[begin->getAttackedArgument().getId()] += begin->getMemberCount() - 1;
+
+	//Second pass: fill the rows
+	SparseMatrix returnValue(rowSizes, false);
 	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
 	{
 		auto [memberBegin, memberEnd] = (*begin).getMembersIterator();
@@ -74,49 +115,53 @@ vector<vector<Argument*>> computeAttackedBy(Instance& instance)
 		for (; memberBegin != memberEnd; memberBegin++)
 		{
 			auto& [attackingArgument, _] = *memberBegin;
-			returnValue[attackedArgument->getId()].push_back(attackingArgument);
+			returnValue.addEntry(attackedArgument->getId(), attackingArgument->getId());
 		}
 	}
 	return returnValue;
 }
 
+/**
+ * Adds the values of summand to the values of target
+ */
+void addVector(vector<double>& target, vector<double> const& summand)
+{
+	auto const numberOfValues = (long long)target.size();
+	auto const targetData = target.data();
+	auto const summandData = summand.data();
+
+	#pragma omp parallel for simd schedule(static)
+	for (long long i = 0; i < numberOfValues; i++)
+		targetData[i] += summandData[i];
+}
 
 /**
  * Computes the path length heuristics value for each argument a, i.e. sum_{i=1}^n d_i^+(a) / 2^i
  */
-vector<double> computePathLength(vector<Argument*> const& arguments, unsigned short const& requestedPathLength, vector<vector<Argument*>> const& attackedBy)
+vector<double> computePathLength(vector<Argument*> const& arguments, unsigned short const& requestedPathLength, SparseMatrix const& attackedBy)
 {
 	vector<double> values(arguments.size(), 0.0);	
 
-	//Idea: one contains the number of paths of length n, the other is used to compute the sum of paths of length n of all attacked arguments and thus the paths of length n + 1 from the current argument
-	vector<vector<unsigned long>> helper(2, vector<unsigned long>(arguments.size()));
+	//Idea: current contains the number of paths of length n already divided by 2^n, next is used to compute the sum over all attacked arguments and thus the paths of length n + 1 from the current argument
+	//Keeping the path counts scaled avoids the overflow of the counts and the pow call per argument
+	vector<double> current(arguments.size()), next(arguments.size());
 	
 	//Path length 1
 	for (ID i = 0; i < arguments.size(); i++)
 	{
-		helper[0][i] = arguments[i]->getHeuristicsValue();
-		values[i] = arguments[i]->getHeuristicsValue() / 2.0;
+		current[i] = arguments[i]->getHeuristicsValue() / 2.0;
+		values[i] = current[i];
 	}
 
 	//Paths length 2...n
-	size_t workingIndex = 1, prevResultIndex = 0;
 	for (unsigned short pathLength = 2; pathLength <= requestedPathLength; pathLength++)
 	{		
-		for (ID i = 0; i < arguments.size(); i++)
-		{			
-			helper[workingIndex][i] = 0;
-
-			//For each argument, add the number of paths with the previous length for each argument that attacks it
-			for (auto& attacker : attackedBy[i])		
-				helper[workingIndex][i] += helper[prevResultIndex][attacker->getId()];
+		//For each argument, add the number of paths with the previous length for each argument that attacks it
+		attackedBy.multiply(current, next, 0.5);
 
-			//Update the heuristics value
-			values[i] += ((double)helper[workingIndex][i]) / (double)pow(2.0, pathLength);			
-		}
-
-		//Swap workingIndex and prevResultIndex
-		workingIndex = (workingIndex + 1) % 2;
-		prevResultIndex = (prevResultIndex + 1) % 2;
+		//Update the heuristics value
+		addVector(values, next);
+		swap(current, next);
 	}		
 
 	return values;
@@ -125,42 +170,27 @@ vector<double> computePathLength(vector<Argument*> const& arguments, unsigned sh
 /**
  * Modifies the path length heuristics value for each argument a by adding sum_{i=1}^n d_i^-(a) / (-2)^i - |{b | (b, a) \in R} / 2
  */
-void computeModifiedPathLength(vector<Argument*> const& arguments, unsigned short const& requestedPathLength, vector<double>& pathLenghtValues)
+void computeModifiedPathLength(vector<Argument*> const& arguments, unsigned short const& requestedPathLength, SparseMatrix const& attackedBy, vector<double>& pathLenghtValues)
 {	
-	//Idea: one contains the number of paths of length n, the other is used to compute the sum of paths of length n of attacking arguments and thus the paths of length n + 1 from the current argument
-	vector<vector<unsigned long>> helper(2, vector<unsigned long>(arguments.size()));
+	//Idea: current contains the number of paths of length n already divided by (-2)^n, next is used to compute the sum over all attacking arguments and thus the paths of length n + 1 from the current argument
+	vector<double> current(arguments.size()), next(arguments.size());
 
 	//Path length 1
 	for (ID i = 0; i < arguments.size(); i++)
 	{
-		helper[0][i] = arguments[i]->getAttackedByCount();
-		pathLenghtValues[i] += arguments[i]->getAttackedByCount() / -2.0;
+		current[i] = arguments[i]->getAttackedByCount() / -2.0;
+		pathLenghtValues[i] += current[i];
 	}
 
 	//Paths length 2...n
-	size_t workingIndex = 1, prevResultIndex = 0;
 	for (unsigned short pathLength = 2; pathLength <= requestedPathLength; pathLength++)
 	{
-		for (ID i = 0; i < arguments.size(); i++)
-		{
-			helper[workingIndex][i] = 0;
-
-			//For each argument, add the number of paths with the previous length for each argument that attacks it			
-			for (auto [begin, end] = arguments[i]->getAttackedByIterator(); begin != end; begin++)
-			{
-				auto [beginAttackers, endAttackers] = (*begin)->getMembersIterator();
-				beginAttackers++; //Skip attacked argument				
-				for(; beginAttackers != endAttackers; beginAttackers++)
-					helper[workingIndex][i] += helper[prevResultIndex][beginAttackers->first->getId()];
-			}
-
-			//Update the heuristics value
-			pathLenghtValues[i] += ((double)helper[workingIndex][i]) / (double)pow(-2.0, pathLength);
-		}
+		//For each argument, add the number of paths with the previous length for each argument that attacks it
+		attackedBy.multiply(current, next, -0.5);
 
-		//Swap workingIndex and prevResultIndex
-		workingIndex = (workingIndex + 1) % 2;
-		prevResultIndex = (prevResultIndex + 1) % 2;
+		//Update the heuristics value
+		addVector(pathLenghtValues, next);
+		swap(current, next);
 	}
 
 	//Add the last term
@@ -168,6 +198,140 @@ void computeModifiedPathLength(vector<Argument*> const& arguments, unsigned shor
 		pathLenghtValues[i] -= arguments[i]->getAttackedByCount() / 2;	
 }
 
+/**
+ * {@return a matrix that, for each argument, contains all arguments it attacks. Every attack distributes its weight evenly over its support, i.e. the entry for an attack with support T is 1 / |T|, further divided by the number of attacks on the target if normalizeByTarget is set}
+ */
+SparseMatrix computeSupportedAttacks(Instance& instance, bool const& normalizeByTarget)
+{
+	//First pass: count the entries of each row and the number of attacks with non-empty support on each argument
+	vector<size_t> rowSizes(instance.getNumberOfArguments(), 0);
+	vector<size_t> incomingAttacks(instance.getNumberOfArguments(), 0);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = (*begin).getMembersIterator();
+		if (begin->getMemberCount() > 1)
+			incomingAttacks[begin->getAttackedArgument().getId()]++;
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			rowSizes[memberBegin->first->getId()]++;
+	}
+
+	//Second pass: fill the rows
+	SparseMatrix returnValue(rowSizes, true);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = (*begin).getMembersIterator();
+		
+		auto attackedArgumentId = memberBegin->first->getId();
+		auto weight = 1.0 / (double)(begin->getMemberCount() - 1);
+		if (normalizeByTarget)
+			weight /= (double)incomingAttacks[attackedArgumentId];
+
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			returnValue.addEntry(memberBegin->first->getId(), attackedArgumentId, weight);
+	}
+	return returnValue;
+}
+
+/**
+ * Scales the values to sum up to 1 and returns the L1 distance to the previous values
+ */
+double normalizeAndCompare(vector<double>& values, vector<double> const& previousValues)
+{
+	auto const numberOfValues = (long long)values.size();
+	auto const data = values.data();
+	auto const previousData = previousValues.data();
+
+	double sum = 0.0;
+	#pragma omp parallel for simd schedule(static) reduction(+:sum)
+	for (long long i = 0; i < numberOfValues; i++)
+		sum += data[i];
+
+	//Every value is non-negative, thus a sum of 0 means that everything is 0 and there is nothing to scale
+	auto const factor = sum > 0.0 ? 1.0 / sum : 1.0;
+	double distance = 0.0;
+	#pragma omp parallel for simd schedule(static) reduction(+:distance)
+	for (long long i = 0; i < numberOfValues; i++)
+	{
+		data[i] *= factor;
+		distance += fabs(data[i] - previousData[i]);
+	}
+
+	return distance;
+}
+
+/**
+ * Computes the PageRank of each argument, where an argument receives rank from the arguments it attacks, split evenly over the attacks on the target and over the support of each attack
+ * Stops once the L1 distance of two iterations is below the tolerance or after the given number of iterations
+ */
+vector<double> computePageRank(Instance& instance, unsigned short const& maximumIterations, double const& tolerance)
+{
+	//The damping factor, i.e. the probability of following an attack instead of jumping to a random argument
+	const double damping = 0.85;
+
+	auto numberOfArguments = instance.getNumberOfArguments();
+	auto supportedAttacks = computeSupportedAttacks(instance, true);
+
+	//Arguments without incoming attacks have nowhere to pass their rank to, thus it is distributed over all arguments
+	vector<ID> danglingArguments;
+	for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
+	{
+		auto [attackBegin, attackEnd] = begin->getAttackedByIterator();
+		if (none_of(attackBegin, attackEnd, [](Clause* const& attack) { return attack->getMemberCount() > 1; }))
+			danglingArguments.push_back(begin->getId());
+	}
+
+	vector<double> current(numberOfArguments, 1.0 / (double)numberOfArguments), next(numberOfArguments);
+	for (unsigned short iteration = 0; iteration < maximumIterations; iteration++)
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		double danglingRank = 0.0;
+		for (auto& id : danglingArguments)
+			danglingRank += current[id];
+
+		supportedAttacks.multiply(current, next, damping);
+		auto const base = (1.0 - damping + damping * danglingRank) / (double)numberOfArguments;
+		auto const nextData = next.data();
+		#pragma omp parallel for simd schedule(static)
+		for (long long i = 0; i < (long long)numberOfArguments; i++)
+			nextData[i] += base;
+
+		auto distance = normalizeAndCompare(next, current);
+		swap(current, next);
+		if (distance < tolerance)
+			break;
+	}
+
+	return current;
+}
+
+/**
+ * Computes the eigenvector centrality of each argument, where an argument is central if it attacks central arguments and every attack splits its weight evenly over its support
+ * To guarantee convergence on graphs that are not strongly connected, the iteration uses the shifted matrix I + A, which has the same eigenvectors
+ * Stops once the L1 distance of two iterations is below the tolerance or after the given number of iterations
+ */
+vector<double> computeEigenvectorCentrality(Instance& instance, unsigned short const& maximumIterations, double const& tolerance)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+	auto supportedAttacks = computeSupportedAttacks(instance, false);
+
+	vector<double> current(numberOfArguments, 1.0 / (double)numberOfArguments), next(numberOfArguments);
+	for (unsigned short iteration = 0; iteration < maximumIterations; iteration++)
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		supportedAttacks.multiply(current, next, 1.0);
+		addVector(next, current);
+
+		auto distance = normalizeAndCompare(next, current);
+		swap(current, next);
+		if (distance < tolerance)
+			break;
+	}
+
+	return current;
+}
+
 pair<vector<Argument*>, vector<Sign>> Heuristics::apply(Instance& instance, DL const& dl) const
 {
 	auto arguments = instance.getArgumentsCopy();		
@@ -181,13 +345,24 @@ pair<vector<Argument*>, vector<Sign>> Heuristics::apply(Instance& instance, DL c
 		auto attackedBy = computeAttackedBy(instance);
 		auto pathLengthValues = computePathLength(arguments, pathLength, attackedBy);
 		if (type == HeuristicTypes::PathLengthModified)
-			computeModifiedPathLength(arguments, pathLength, pathLengthValues);
+			computeModifiedPathLength(arguments, pathLength, attackedBy, pathLengthValues);
 
 		//Update the heuristics value
 		for (ID i = 0; i < arguments.size(); i++)
 			arguments[i]->setHeuristicsValue(pathLengthValues[i]);
 	}	
 
+	//For the centrality heuristics
+	if (type == HeuristicTypes::PageRank || type == HeuristicTypes::EigenvectorCentrality)
+	{
+		auto maximumIterations = std::get<unsigned short>(heuristicsParameter1);
+		auto tolerance = std::get<double>(heuristicsParameter2);
+
+		auto centralityValues = type == HeuristicTypes::PageRank ? computePageRank(instance, maximumIterations, tolerance) : computeEigenvectorCentrality(instance, maximumIterations, tolerance);
+		for (ID i = 0; i < arguments.size(); i++)
+			arguments[i]->setHeuristicsValue(centralityValues[i]);
+	}
+
 	//project to arguments without a set value
 	for(size_t i = 0; i < arguments.size(); i++)
 		if (arguments[i]->getValue(dl) != 0)
@@ -210,6 +385,8 @@ pair<vector<Argument*>, vector<Sign>> Heuristics::apply(Instance& instance, DL c
 		case HeuristicTypes::MaxOutDegree:
 		case HeuristicTypes::PathLength:
 		case HeuristicTypes::PathLengthModified:
+		case HeuristicTypes::PageRank:
+		case HeuristicTypes::EigenvectorCentrality:
 			//Sort descending
 			std::sort(arguments.begin(), arguments.end(),
 				[&](Argument* const& first, Argument* const& second) { return first->getHeuristicsValue() > second->getHeuristicsValue(); });
@@ -1,5 +1,6 @@
 #include "../../header/datamodel/Instance.hpp"
 #include "../../header/tools/Helper.hpp"
+#include "../../header/tools/ProofWriter.hpp"
 #include <cassert>
 #include <iostream>
 #include <fmt/core.h>
@@ -16,9 +17,48 @@ Instance::Instance(ID const& numArguments, ID const& numAttacks)
 		arguments.emplace_back(i);
 
 	for (ID i = 0; i < numAttacks; i++)
-		attacks.emplace_back(i, Clause::ClauseType::Attack);	
+	{
+		attacks.emplace_back(i, Clause::ClauseType::Attack);
+		attacks.back().setProofId(i + 1);
+	}
 
 	nextClauseID = attacks.size();
+	numberOfInputAttacks = numAttacks;
+}
+
+Instance Instance::getSubInstance(vector<ID> const& argumentIds, vector<ID> const& attackIds, vector<ID> const& localIds)
+{
+	Instance subInstance(argumentIds.size(), attackIds.size());
+	subInstance.setNumberOfInputAttacks(numberOfInputAttacks);
+
+	for (ID i = 0; i < argumentIds.size(); i++)
+	{
+		subInstance.getArgument(i).setName(getArgument(argumentIds[i]).getName());
+		subInstance.getArgument(i).setNumber(getArgument(argumentIds[i]).getNumber());
+	}
+
+	for (ID i = 0; i < attackIds.size(); i++)
+	{
+		auto& attack = getAttack(attackIds[i]);
+		auto& subAttack = subInstance.getAttack(i);
+		subAttack.setProofId(attack.getProofId());
+		auto [memberBegin, memberEnd] = attack.getMembersIterator();
+		subAttack.setAttacked(subInstance.getArgument(localIds[memberBegin->first->getId()]), memberBegin->second);
+
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+		{
+			auto& subMember = subInstance.getArgument(localIds[memberBegin->first->getId()]);
+			subAttack.addArgument(subMember, memberBegin->second);
+
+			//Same initialization of the heuristics value as done by the parser
+			subMember.setHeuristicsValue(subMember.getHeuristicsValue() + 1.0);
+		}
+
+		if (attack.isSelfAttack())
+			subAttack.markAsSelfAttack();
+	}
+
+	return subInstance;
 }
 
 Clause& Instance::getAttack(ID const& id)
@@ -94,6 +134,24 @@ size_t Instance::getNumberOfAttacks() const
 	return attacks.size();
 }
 
+void Instance::setNumberOfInputAttacks(ID const& numberOfInputAttacks)
+{
+	this->numberOfInputAttacks = numberOfInputAttacks;
+}
+
+ID Instance::getNumberOfInputAttacks() const
+{
+	return numberOfInputAttacks;
+}
+
+size_t Instance::getMaximumSupportSize() const
+{
+	size_t maximumSize = 0;
+	for (auto& attack : attacks)
+		maximumSize = max(maximumSize, attack.getMemberCount() - 1 + (attack.isSelfAttack() ? 1 : 0));
+	return maximumSize;
+}
+
 Clause& Instance::getNewClause(size_t const& capacity, Clause::ClauseType const& clauseType)
 {	
 	if (availableClauses.empty())
@@ -128,6 +186,12 @@ Clause& Instance::getNewLearnedClause(const size_t& capacity)
 	return clause;
 }
 
+Clause& Instance::getNewPermanentClause(const size_t& capacity)
+{
+	//Not added to the learned clauses, which are the ones that are forgotten
+	return getNewClause(capacity, Clause::ClauseType::Learned);
+}
+
 void Instance::recycleClause(Clause& clause)
 {
 	if (clause.isForgotten()) //Only clauses that are marked as forgotten can be recycled
@@ -144,6 +208,9 @@ void Instance::recycleClause(Clause& clause)
 			Helper::swapRemove(forgottenClauses, clause.getForgottenIndex());
 			forgottenClauses[clause.getForgottenIndex()]->setForgottenIndex(clause.getForgottenIndex());
 		}
+
+		if (deletionProof != nullptr)
+			deletionProof->writeClause(ProofWriter::LineKind::Deletion, clause);
 		availableClauses.push_back(&clause);
 	}
 }
@@ -153,17 +220,20 @@ size_t Instance::getNumberOfLearnedClauses() const
 	return learnedClauses.size();
 }
 
-void Instance::forgetClauses(size_t amountOfClausesToForget, std::unique_ptr<ofstream>& proofFile, bool generateProof)
+void Instance::forgetClauses(size_t amountOfClausesToForget, std::unique_ptr<ProofWriter>& proofFile, bool generateProof)
 {
 	assert(amountOfClausesToForget <= learnedClauses.size());
+	deletionProof = generateProof ? proofFile.get() : nullptr;
 	while (amountOfClausesToForget-- > 0)
 	{
 		Clause* clause = learnedClauses.front();
-		if (generateProof)
-			writeProofClause(clause, proofFile);
-
 		if (clause->isNotUsed())
-			availableClauses.push_back(clause); //Clause is not used anywhere and thus can be made available again
+		{
+			//Clause is not used anywhere and thus can be made available again
+			if (generateProof)
+				proofFile->writeClause(ProofWriter::LineKind::Deletion, *clause);
+			availableClauses.push_back(clause);
+		}
 		else
 		{
 			//Clause is still used somewhere and thus we cant make it available again yet
@@ -1,13 +1,29 @@
 #include "../header/main.hpp"
 #include "../header/Solver.hpp"
+#include "../header/ComponentSolver.hpp"
+#include "../header/ModelCounter.hpp"
+#include "../header/TreeDecompositionSolver.hpp"
+#include "../header/Preprocessor.hpp"
+#include "../header/FixedAritySolver.hpp"
+#include "../header/tools/TreeDecomposition.hpp"
+#include "../header/tools/BigUnsigned.hpp"
 #include "../header/tools/Helper.hpp"
+#include "../header/tools/ProofWriter.hpp"
+#include "../header/tools/ModelSink.hpp"
+#include "../header/tools/BitsetModelSink.hpp"
+#include "../header/tools/AsyncModelSink.hpp"
+#include "../header/tools/SearchStatistics.hpp"
 #include "../header/datamodel/Instance.hpp"
 #include "../header/datamodel/Heuristics.hpp"
 #include "../header/datamodel/Semantics.hpp"
+#include "../header/datamodel/Engine.hpp"
 #include "../header/Parsing/Parser.hpp"
 #include "./parsing/ParserSimpleFormat.cpp"
 
 #include <chrono>
+#include <csignal>
+#include <cstring>
+#include <cstdio>
 #include <unistd.h>
 #include <getopt.h>
 #include <filesystem>
@@ -50,7 +66,57 @@ double percentageSolved = 0;
 
 unsigned long modelCount = 0;
 
-int PrintSummary()
+/**
+ * The number of times and the time in seconds the search waited for the asynchronous output, and the number of models it dropped
+ */
+unsigned long outputWaitCount = 0;
+double outputWaitSeconds = 0;
+unsigned long droppedModelCount = 0;
+
+/**
+ * The exact number of models if they have only been counted, which might exceed the range of modelCount
+ */
+optional<BigUnsigned> exactModelCount;
+
+/**
+ * The counters of the search of the clause learning solvers
+ */
+SearchStatistics searchStatistics;
+
+/**
+ * The file the summary is additionally written to as JSON or null. Opened while parsing the arguments, such that a file that can't be written is rejected before solving
+ */
+FILE* summaryFile = nullptr;
+
+/**
+ * Writes the summary as single JSON object to the summary file and closes it, such that it can be processed without parsing the printed summary
+ */
+void WriteJsonSummary(int const& exitCode, double const& runtime, double const& userTime, double const& systemTime)
+{
+	char const* status = "finished";
+	switch (Helper::getSignalType())
+	{
+		case Helper::SignalType::Alarm:
+			status = "timeout";
+			break;
+		case Helper::SignalType::Interrupt:
+		case Helper::SignalType::Terminate:
+			status = "interrupted";
+			break;
+		default:
+			break;
+	}
+
+	auto firstModel = modelCount != 0 ? fmt::format("{:.3f}", ((chrono::duration<double>)(firstModelTime - startTime)).count()) : "null";
+	fmt::print(summaryFile, "{{\"status\": \"{}\", \"exitCode\": {}, \"models\": {}, \"runtime\": {:.3f}, \"userTime\": {:.3f}, \"systemTime\": {:.3f}, \"firstModelTime\": {}, "
+		"\"percentageSolved\": {:.9f}, \"outputWaits\": {}, \"outputWaitTime\": {:.3f}, \"droppedModels\": {}, \"stabilityWatchPeakMemory\": {}, \"search\": {}}}\n",
+		status, exitCode, exactModelCount ? exactModelCount->toString() : to_string(modelCount), runtime, userTime, systemTime, firstModel, percentageSolved * 100,
+		outputWaitCount, outputWaitSeconds, droppedModelCount, Argument::getStabilityWatchPeakMemory(), searchStatistics.isEmpty() ? "null" : searchStatistics.toJson());
+	fclose(summaryFile);
+	summaryFile = nullptr;
+}
+
+int PrintSummary(int const& exitCode)
 {
 	chrono::time_point<chrono::high_resolution_clock> endTime = chrono::high_resolution_clock::now();
 	struct rusage usageValues;
@@ -74,27 +140,70 @@ int PrintSummary()
 			break;			
 	}
 
-	cout << "Finished." << endl << "Models found: " << modelCount << endl;
+	double runtime = ((chrono::duration<double>)(endTime - startTime)).count();
+	double userTime = (double)usageValues.ru_utime.tv_sec + (double)usageValues.ru_utime.tv_usec / (double)1000000;
+	double systemTime = (double)usageValues.ru_stime.tv_sec + (double)usageValues.ru_stime.tv_usec / (double)1000000;
+	cout << "Finished." << endl << "Models found: " << (exactModelCount ? exactModelCount->toString() : to_string(modelCount)) << endl;
 	if (modelCount != 0)
-		printf("Runtime (s): %.3f (user: %.3f, system: %.3f, first Model: %.3f)\n", ((chrono::duration<double>)(endTime - startTime)).count(), (double)usageValues.ru_utime.tv_sec + (double)usageValues.ru_utime.tv_usec / (double)1000000, (double)usageValues.ru_stime.tv_sec + (double)usageValues.ru_stime.tv_usec / (double)1000000, ((chrono::duration<double>)(firstModelTime - startTime)).count());
+		printf("Runtime (s): %.3f (user: %.3f, system: %.3f, first Model: %.3f)\n", runtime, userTime, systemTime, ((chrono::duration<double>)(firstModelTime - startTime)).count());
 	else
-		printf("Runtime (s): %.3f (user: %.3f, system: %.3f)\n", ((chrono::duration<double>)(endTime - startTime)).count(), (double)usageValues.ru_utime.tv_sec + (double)usageValues.ru_utime.tv_usec / (double)1000000, (double)usageValues.ru_stime.tv_sec + (double)usageValues.ru_stime.tv_usec / (double)1000000);
+		printf("Runtime (s): %.3f (user: %.3f, system: %.3f)\n", runtime, userTime, systemTime);
+	if (!searchStatistics.isEmpty())
+		searchStatistics.print();
+	if (outputWaitCount != 0)
+		printf("Output waits: %lu (s: %.3f)\n", outputWaitCount, outputWaitSeconds);
+	if (droppedModelCount != 0)
+		printf("Models dropped by the output: %lu\n", droppedModelCount);
+	if (Argument::getStabilityWatchPeakMemory() != 0)
+		printf("Stability watch memory (bytes): %zu\n", Argument::getStabilityWatchPeakMemory());
 	printf("Percentage solved: %.9f", percentageSolved * 100);
+
+	if (summaryFile != nullptr)
+	{
+		fflush(stdout);
+		WriteJsonSummary(exitCode, runtime, userTime, systemTime);
+	}
 	return 0;
 }
 
+/**
+ * Enumerates the extensions of an instance whose attacks have at most the given number of supporting arguments
+ */
+template <size_t Arity>
+void solveFixedArity(Instance& instance, Heuristics const& heuristics, Preprocessor const* reconstruction, unsigned long& numberOfModels, ModelSink& modelSink)
+{
+	FixedAritySolver<Arity> solver(instance, heuristics, firstModelTime, modelCount, percentageSolved, numberOfModels, modelSink);
+	solver.setReconstruction(reconstruction);
+	solver.solve();
+}
+
 int parseAndSolve(int argc, char** argv)
 {
 	Semantics semantics;
 	Heuristics heuristics;
+	Engine engine;
 	bool printModels = true;
+	bool sccRecursive = false;
+	bool decompose = false;
+	bool preprocess = false;
+	bool detectEquivalences = false;
+	bool useStabilityCounters = false;
+	auto proofFormat = ProofWriter::Format::Text;
+	auto modelFileCompression = BitsetModelSink::Compression::None;
+	optional<AsyncModelSink::Backpressure> outputBackpressure;
+	bool proofHints = false;
 	unsigned long numberOfModels = 0;
+	unsigned long keyframeInterval = 0;
 	double clauseLearningForgetPercentage = 0.5;
 	double clauseLearningGrowthRate = 2;
-	char* instancePath = nullptr, *descriptionPath = nullptr, *requiredArgumentsPath = nullptr, *proofPath = nullptr;;
+	unsigned long cacheLimitMegabytes = 1024;
+	size_t maximumWidth = 10;
+	unsigned long probingBudget = 0;
+	char* instancePath = nullptr, *descriptionPath = nullptr, *requiredArgumentsPath = nullptr, *proofPath = nullptr, *modelFilePath = nullptr;
+	bool isProofStreamed = false;
 
 	int c;	
-	while ((c = getopt(argc, argv, "i:d:r:s:n:t:p:g:h:q:c:")) != -1)
+	while ((c = getopt(argc, argv, "i:d:r:s:n:t:p:g:h:qc:kxe:m:w:af:zublj:o:y:v:J:")) != -1)
 	{
 		Helper::throwExceptionIfReceivedSignal();
 
@@ -190,6 +299,130 @@ int parseAndSolve(int argc, char** argv)
 				printModels = false;
 				break;
 
+			case 'k':
+				sccRecursive = true;
+				break;
+
+			case 'x':
+				decompose = true;
+				break;
+
+			case 'a':
+				preprocess = true;
+				break;
+
+			case 'z':
+				detectEquivalences = true;
+				break;
+
+			case 'u':
+				useStabilityCounters = true;
+				break;
+
+			case 'b':
+				proofFormat = ProofWriter::Format::Binary;
+				break;
+
+			case 'l':
+				proofHints = true;
+				break;
+
+			case 'f':
+				if (optional<unsigned long> parsedBudget = Helper::tryParseULong(string(optarg)))
+					probingBudget = *parsedBudget;
+				else
+				{
+					cout << "The supplied probing budget is invalid" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'j':
+			{
+				auto interval = Helper::tryParseULong(string(optarg));
+				if (interval.has_value() && *interval > 0)
+					keyframeInterval = *interval;
+				else
+				{
+					cout << "The supplied keyframe interval is invalid" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+			}
+
+			case 'o':
+				modelFilePath = optarg;
+				if (filesystem::exists(modelFilePath))
+				{
+					cout << "The supplied model file already exist" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'y':
+				if (auto parsedCompression = BitsetModelSink::tryParseCompression(optarg))
+					modelFileCompression = *parsedCompression;
+				else
+				{
+					cout << fmt::format("Unknown or unavailable compression: {}", optarg) << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'v':
+				if (auto parsedBackpressure = AsyncModelSink::tryParseBackpressure(optarg))
+					outputBackpressure = *parsedBackpressure;
+				else
+				{
+					cout << fmt::format("Unknown backpressure: {}", optarg) << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'J':
+				if (summaryFile != nullptr)
+					fclose(summaryFile);
+				summaryFile = fopen(optarg, "w");
+				if (summaryFile == nullptr)
+				{
+					cout << "Failed to open the summary file" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'e':
+				if (auto parsedEngine = Engine::tryParse(optarg))
+					engine = *parsedEngine;
+				else
+				{
+					cout << fmt::format("Unkown engine: {}", optarg) << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'm':
+				if (optional<unsigned long> parsedCacheLimit = Helper::tryParseULong(string(optarg)))
+					cacheLimitMegabytes = *parsedCacheLimit;
+				else
+				{
+					cout << "The supplied cache limit is invalid" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			case 'w':
+			{
+				auto width = Helper::tryParseUInt(optarg);
+				if (width.has_value() && *width <= TreeDecompositionSolver::maximumWidth)
+					maximumWidth = *width;
+				else
+				{
+					cout << fmt::format("The supplied width is invalid, it must be at most {}", TreeDecompositionSolver::maximumWidth) << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+			}
+
 			case 'h':
 				if (auto parsedHeuristics = Heuristics::tryParse(optarg))
 					heuristics = *parsedHeuristics;
@@ -201,7 +434,8 @@ int parseAndSolve(int argc, char** argv)
 				break;
 			case 'c':
 				proofPath = optarg;
-				if (filesystem::exists(proofPath))
+				isProofStreamed = strcmp(proofPath, "-") == 0 || filesystem::is_fifo(proofPath);
+				if (!isProofStreamed && filesystem::exists(proofPath))
 				{
 					cout << "The supplied proof file already exist" << endl;
 					return EXIT_CODE_ARGUMENTS;
@@ -225,11 +459,51 @@ int parseAndSolve(int argc, char** argv)
 		return EXIT_CODE_ARGUMENTS;
 	}
 
-	auto proofFile = std::make_unique<ofstream>(nullptr);
+	if (engine.getType() == Engine::EngineType::Counting && (printModels || proofPath != nullptr))
+	{
+		cout << "The counting engine only counts the models, thus it requires -q and does not support proofs" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	if (modelFilePath != nullptr && (!printModels || keyframeInterval != 0))
+	{
+		cout << "The model file replaces the printed models, thus it does not support -q and -j" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	if (outputBackpressure && !printModels)
+	{
+		cout << "The output thread only prints or writes the models, thus it does not support -q" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	if (engine.getType() == Engine::EngineType::TreeDecomposition && proofPath != nullptr)
+	{
+		cout << "The tree decomposition engine does not support proofs" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	if (engine.getType() == Engine::EngineType::FixedArity && proofPath != nullptr)
+	{
+		cout << "The fixed arity engine does not support proofs" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	if (preprocess && proofPath != nullptr)
+	{
+		cout << "Preprocessing does not support proofs, as they would refer to the reduced instance" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	unique_ptr<ProofWriter> proofFile;
 	if (proofPath != nullptr)
 	{
-		proofFile = std::make_unique<ofstream>(proofPath, ios::out | ios::binary);
-		if (proofFile->fail())
+		//A checker reading the proof from a pipe might stop early, the search is then finished without writing the proof
+		if (isProofStreamed)
+			signal(SIGPIPE, SIG_IGN);
+
+		proofFile = std::make_unique<ProofWriter>(proofPath, proofFormat, proofHints);
+		if (!proofFile->isOpen())
 		{
 			cout << "Failed to open proof file" << endl;
 			return EXIT_CODE_ARGUMENTS;
@@ -238,15 +512,144 @@ int parseAndSolve(int argc, char** argv)
 
 	auto parser = std::unique_ptr<Parser>{ nullptr };
 	parser = std::make_unique<ParserSimpleFormat>(instancePath, descriptionPath, requiredArgumentsPath);	
-	Instance instance = parser->getInstance();		
-	
-	Solver solver(instance, semantics, heuristics, firstModelTime, modelCount, percentageSolved, numberOfModels, printModels, clauseLearningForgetPercentage, clauseLearningGrowthRate, proofFile);
-	solver.solve();
+	Instance parsedInstance = parser->getInstance();		
+	if (proofFile)
+		proofFile->setNumberOfInputClauses(parsedInstance.getNumberOfInputAttacks());
+
+	//The preprocessor has to outlive the search, as it maps the models back to the parsed instance
+	optional<Preprocessor> preprocessor;
+	optional<Instance> reducedInstance;
+	if (preprocess)
+	{
+		preprocessor.emplace(parsedInstance);
+		reducedInstance.emplace(preprocessor->reduce());
+		preprocessor->printReport(*reducedInstance);
+	}
+	Instance& instance = reducedInstance ? *reducedInstance : parsedInstance;
+	Preprocessor const* reconstruction = preprocessor ? &*preprocessor : nullptr;
+
+	//The models are always passed as models of the parsed instance. The sink writes the remaining models when it is destroyed, also if the search is interrupted
+	unique_ptr<ModelSink> modelSink;
+	if (modelFilePath != nullptr)
+	{
+		auto bitsetModelSink = std::make_unique<BitsetModelSink>(modelFilePath, parsedInstance, modelFileCompression);
+		if (!bitsetModelSink->isOpen())
+		{
+			cout << "Failed to open model file" << endl;
+			return EXIT_CODE_ARGUMENTS;
+		}
+		modelSink = std::move(bitsetModelSink);
+	}
+	else if (printModels && keyframeInterval != 0)
+		modelSink = std::make_unique<DeltaModelSink>(parsedInstance, keyframeInterval);
+	else if (printModels)
+		modelSink = std::make_unique<TextModelSink>(parsedInstance);
+	else
+		modelSink = std::make_unique<CountingModelSink>();
+
+	if (outputBackpressure)
+		modelSink = std::make_unique<AsyncModelSink>(std::move(modelSink), parsedInstance.getNumberOfArguments(), *outputBackpressure, outputWaitCount, outputWaitSeconds, droppedModelCount);
+
+	//The dynamic programming engine is chosen automatically if the width is small, unless a proof or an option of the clause based solver is given
+	bool usesClauseLearningOptions = decompose || sccRecursive || probingBudget != 0 || detectEquivalences || useStabilityCounters;
+	optional<TreeDecomposition> decomposition;
+	if (engine.getType() == Engine::EngineType::TreeDecomposition)
+	{
+		decomposition = TreeDecomposition::tryCompute(instance, maximumWidth);
+		if (!decomposition)
+			cout << fmt::format("The width of the instance exceeds {}, thus it is solved by enumeration", maximumWidth) << endl;
+	}
+	else if (engine.getType() == Engine::EngineType::Auto && proofPath == nullptr && !usesClauseLearningOptions)
+		decomposition = TreeDecomposition::tryCompute(instance, maximumWidth);
+
+	//The tables of the dynamic programming engine might exceed the memory limit, the instance is then solved as if its width was too large
+	bool isSolved = false;
+	if (preprocessor && preprocessor->isInconsistent())
+	{
+		//The required arguments contradict the grounded extension or each other after merging
+		percentageSolved = 1.0;
+		isSolved = true;
+	}
+	else if (decomposition)
+	{
+		TreeDecompositionSolver solver(instance, *decomposition, firstModelTime, modelCount, exactModelCount, percentageSolved, numberOfModels, *modelSink, cacheLimitMegabytes * 1024 * 1024);
+		solver.setReconstruction(reconstruction);
+		isSolved = solver.solve();
+		if (!isSolved)
+		{
+			if (engine.getType() == Engine::EngineType::TreeDecomposition)
+				cout << "The tables of the tree decomposition exceed the memory limit, thus the instance is solved by enumeration" << endl;
+			decomposition.reset();
+		}
+	}
+
+	//Plain frameworks are enumerated with the fast path unless an option of the clause based solver is given
+	size_t arity = 0;
+	if (engine.getType() == Engine::EngineType::FixedArity)
+	{
+		arity = instance.getMaximumSupportSize();
+		if (arity > 3)
+		{
+			cout << "The attacks of the instance have more than 3 supporting arguments, thus it is solved by enumeration" << endl;
+			arity = 0;
+		}
+	}
+	else if (engine.getType() == Engine::EngineType::Auto && !decomposition && proofPath == nullptr && !usesClauseLearningOptions && instance.getMaximumSupportSize() <= 1)
+		arity = 1;
+
+	if (isSolved)
+	{
+		//Solved by the dynamic programming engine or inconsistent after preprocessing
+	}
+	else if (arity == 1)
+		solveFixedArity<1>(instance, heuristics, reconstruction, numberOfModels, *modelSink);
+	else if (arity == 2)
+		solveFixedArity<2>(instance, heuristics, reconstruction, numberOfModels, *modelSink);
+	else if (arity == 3)
+		solveFixedArity<3>(instance, heuristics, reconstruction, numberOfModels, *modelSink);
+	else if (engine.getType() == Engine::EngineType::Counting)
+	{
+		//The counter splits into components on its own, thus decompose is not needed
+		ModelCounter counter(instance, cacheLimitMegabytes * 1024 * 1024);
+		auto count = counter.count();
+		if (numberOfModels != 0 && BigUnsigned(numberOfModels) < count)
+			count = BigUnsigned(numberOfModels);
+		modelCount = count.toULongSaturated();
+		if (modelCount != 0)
+			firstModelTime = chrono::high_resolution_clock::now();
+		exactModelCount = count;
+		percentageSolved = 1.0;
+	}
+	else if (decompose)
+	{
+		ComponentSolver solver(instance, semantics, heuristics, firstModelTime, modelCount, exactModelCount, percentageSolved, numberOfModels, *modelSink, sccRecursive, clauseLearningForgetPercentage, clauseLearningGrowthRate, proofFile);
+		solver.setReconstruction(reconstruction);
+		solver.setProbingBudget(probingBudget);
+		solver.setDetectEquivalences(detectEquivalences);
+		solver.setUseStabilityCounters(useStabilityCounters);
+		solver.solve();
+		searchStatistics += solver.getStatistics();
+	}
+	else
+	{
+		//Every combination of the options fixed at compile time has its own solver
+		dispatchSolverPolicy(proofFile != nullptr, useStabilityCounters, [&](auto policy)
+		{
+			Solver<decltype(policy)> solver(instance, semantics, heuristics, firstModelTime, modelCount, percentageSolved, numberOfModels, *modelSink, sccRecursive, clauseLearningForgetPercentage, clauseLearningGrowthRate, proofFile);
+			solver.setReconstruction(reconstruction);
+			solver.setProbingBudget(probingBudget);
+			solver.setDetectEquivalences(detectEquivalences);
+			solver.solve();
+			searchStatistics += solver.getStatistics();
+		});
+	}
+
+	modelSink->flush();
 
 	if (proofPath != nullptr)
 	{
 		proofFile->close();
-		if (modelCount != 0)
+		if (modelCount != 0 && !isProofStreamed)
 			std::remove(proofPath);
 	}	
 
@@ -291,7 +694,7 @@ int main(int argc, char** argv)
 		returnValue = EXIT_CODE_UNEXPECTED;
 	}	
 
-	PrintSummary();
+	PrintSummary(returnValue);
 
 	return returnValue;
 }
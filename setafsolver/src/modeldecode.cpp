@@ -0,0 +1,107 @@
+#include "../header/main.hpp"
+#include "../header/tools/ModelDecoder.hpp"
+#include "../header/tools/ModelSink.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/datamodel/Instance.hpp"
+#include "../header/Parsing/Parser.hpp"
+#include "./parsing/ParserSimpleFormat.cpp"
+
+#include <getopt.h>
+#include <fmt/core.h>
+
+using namespace std;
+
+/**
+ * The exit code to be returned when the program arguments are invalid
+ */
+const int EXIT_CODE_ARGUMENTS = 1;
+
+/**
+ * The exit code to be returned when the program was interrupted by some signal
+ */
+const int EXIT_CODE_SIGNALS = 2;
+
+/**
+ * The exit code to be returned when the models could not be decoded
+ */
+const int EXIT_CODE_REJECTED = 3;
+
+/**
+ * The exit code to be returned when a problem occurred during parsing
+ */
+const int EXIT_CODE_PARSING = 4;
+
+/**
+ * The exit code to be returned when something unexpected went wrong
+ */
+const int EXIT_CODE_UNEXPECTED = 20;
+
+int parseAndDecode(int argc, char** argv)
+{
+	char* instancePath = nullptr, *descriptionPath = nullptr, *modelsPath = nullptr;
+
+	int c;
+	while ((c = getopt(argc, argv, "i:d:m:")) != -1)
+	{
+		switch (c)
+		{
+			case 'i':
+				instancePath = optarg;
+				break;
+
+			case 'd':
+				descriptionPath = optarg;
+				break;
+
+			case 'm':
+				modelsPath = optarg;
+				break;
+
+			default:
+				return EXIT_CODE_ARGUMENTS;
+		}
+	}
+
+	if (instancePath == nullptr || modelsPath == nullptr)
+	{
+		cerr << "Usage: modeldecode -i <INSTANCE> -m <MODELS> [-d <DESCRIPTION>]" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	//The decoded output replaces the encoded one, thus messages go to standard error
+	ParserSimpleFormat parser(instancePath, descriptionPath, nullptr);
+	Instance instance = parser.getInstance();
+
+	TextModelSink modelSink(instance);
+	ModelDecoder decoder(instance, modelSink);
+	if (!decoder.decode(modelsPath))
+	{
+		cerr << fmt::format("Decoding failed: {}", decoder.getError()) << endl;
+		return EXIT_CODE_REJECTED;
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Helper::registerSignalHandlers();
+		return parseAndDecode(argc, argv);
+	}
+	catch (Parser::ParserException const& ex)
+	{
+		cerr << ex.what() << endl;
+		return EXIT_CODE_PARSING;
+	}
+	catch (Helper::SignalReceivedException const&)
+	{
+		return EXIT_CODE_SIGNALS;
+	}
+	catch (exception const& ex)
+	{
+		cerr << fmt::format("An unexpected error occurred: {}", ex.what()) << endl;
+		return EXIT_CODE_UNEXPECTED;
+	}
+}
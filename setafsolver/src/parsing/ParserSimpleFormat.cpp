@@ -284,8 +284,8 @@ public:
 		else
 			throw Parser::ParserException("The supplied instance contains no preamble");
 
-		//Buffer the attacks of the instance to be able to sort them first for efficient subsumption test. The bool indicates whether this attack is a superset of another
-		vector<tuple<ID, vector<ID>, bool>> attackBuffer;
+		//Buffer the attacks of the instance to be able to sort them first for efficient subsumption test. The bool indicates whether this attack is a superset of another, the last value is the number of the attack in the file
+		vector<tuple<ID, vector<ID>, bool, ID>> attackBuffer;
 
 		ID attackCount = 0;
 		for (; auto read = instanceReader.getNextEntry(); attackCount++)
@@ -309,7 +309,7 @@ public:
 				if (*it == 0 || *it > numArguments)
 					throw Parser::ParserException(fmt::format("The attack {} refereces argument {} that does not exist", attackCount + 1, *it));
 
-			attackBuffer.emplace_back(line[0], vector<ID>{ line.begin() + 1, line.end() }, false);
+			attackBuffer.emplace_back(line[0], vector<ID>{ line.begin() + 1, line.end() }, false, attackCount + 1);
 		}
 		if (attackCount != numAttacks)
 			throw Parser::ParserException("The instance contains less attacks than specified in the preamble");
@@ -320,7 +320,7 @@ public:
 		//Eliminate subsumed attacks
 		IDTrie trie;
 		size_t subsumedCount = 0;
-		for (auto& [attackedArgument, members, isSubsumed] : attackBuffer)
+		for (auto& [attackedArgument, members, isSubsumed, number] : attackBuffer)
 		{			
 			Helper::throwExceptionIfReceivedSignal();
 
@@ -337,17 +337,20 @@ public:
 
 		//Create the instance
 		Instance instance(numArguments, numAttacks - subsumedCount);
+		instance.setNumberOfInputAttacks(numAttacks);
 		vector<ID> argumentOccurenceWatch(numArguments, 0); //Used to make sure that every argument is only contained once in every clause			
 
 		attackCount = 0;
-		for (auto& [attackedArgumentNumber, members, isSubsumed] : attackBuffer)
+		for (auto& [attackedArgumentNumber, members, isSubsumed, number] : attackBuffer)
 		{
 			Helper::throwExceptionIfReceivedSignal();
 
 			if (isSubsumed)
 				continue;
 
+			//Proofs with hints refer to the attack by its number in the file, which is lost by sorting
 			auto& attack = instance.getAttack(attackCount);
+			attack.setProofId(number);
 			auto& attackedArgument = instance.getArgument(attackedArgumentNumber - 1);
 			attack.setAttacked(attackedArgument, -1);
 
@@ -0,0 +1,163 @@
+#include "../header/main.hpp"
+#include "../header/tools/ProofChecker.hpp"
+#include "../header/tools/ProofWriter.hpp"
+#include "../header/tools/Helper.hpp"
+#include "../header/datamodel/Instance.hpp"
+#include "../header/Parsing/Parser.hpp"
+#include "./parsing/ParserSimpleFormat.cpp"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <getopt.h>
+#include <fmt/core.h>
+
+using namespace std;
+
+/**
+ * The exit code to be returned when the program arguments are invalid
+ */
+const int EXIT_CODE_ARGUMENTS = 1;
+
+/**
+ * The exit code to be returned when the program was interrupted by some signal
+ */
+const int EXIT_CODE_SIGNALS = 2;
+
+/**
+ * The exit code to be returned when the proof has been rejected
+ */
+const int EXIT_CODE_REJECTED = 3;
+
+/**
+ * The exit code to be returned when a problem occurred during parsing
+ */
+const int EXIT_CODE_PARSING = 4;
+
+/**
+ * The exit code to be returned when something unexpected went wrong
+ */
+const int EXIT_CODE_UNEXPECTED = 20;
+
+int parseAndCheck(int argc, char** argv)
+{
+	auto proofFormat = ProofWriter::Format::Text;
+	bool isHinted = true;
+	char* instancePath = nullptr, *descriptionPath = nullptr, *requiredArgumentsPath = nullptr, *proofPath = nullptr, *trimmedProofPath = nullptr;
+
+	int c;
+	while ((c = getopt(argc, argv, "i:d:r:c:but:")) != -1)
+	{
+		switch (c)
+		{
+			case 'i':
+				instancePath = optarg;
+				break;
+
+			case 'd':
+				descriptionPath = optarg;
+				break;
+
+			case 'r':
+				requiredArgumentsPath = optarg;
+				break;
+
+			case 'c':
+				proofPath = optarg;
+				break;
+
+			case 'b':
+				proofFormat = ProofWriter::Format::Binary;
+				break;
+
+			case 'u':
+				isHinted = false;
+				break;
+
+			case 't':
+				trimmedProofPath = optarg;
+				if (strcmp(trimmedProofPath, "-") != 0 && filesystem::exists(trimmedProofPath))
+				{
+					cout << "The supplied trimmed proof file already exist" << endl;
+					return EXIT_CODE_ARGUMENTS;
+				}
+				break;
+
+			default:
+				return EXIT_CODE_ARGUMENTS;
+		}
+	}
+
+	if (instancePath == nullptr || proofPath == nullptr)
+	{
+		cout << "Usage: proofcheck -i <INSTANCE> -c <PROOF> [-d <DESCRIPTION>] [-r <REQUIRED ARGUMENTS>] [-b] [-u] [-t <TRIMMED PROOF>]" << endl;
+		return EXIT_CODE_ARGUMENTS;
+	}
+
+	auto startTime = chrono::high_resolution_clock::now();
+	ParserSimpleFormat parser(instancePath, descriptionPath, requiredArgumentsPath);
+	Instance instance = parser.getInstance();
+
+	//The trimmed proof has hints and the encoding of the checked one, even if the checked one has no hints. It is opened first, as standard output is reserved for it if it is written there
+	unique_ptr<ProofWriter> trimmedProof;
+	if (trimmedProofPath != nullptr)
+	{
+		trimmedProof = make_unique<ProofWriter>(trimmedProofPath, proofFormat, true);
+		if (!trimmedProof->isOpen())
+		{
+			cout << "Failed to open trimmed proof file" << endl;
+			return EXIT_CODE_ARGUMENTS;
+		}
+		trimmedProof->setNumberOfInputClauses(instance.getNumberOfInputAttacks());
+	}
+
+	ProofChecker checker(instance, proofFormat, isHinted, trimmedProof != nullptr);
+	bool isVerified = checker.check(proofPath);
+	if (isVerified)
+		cout << "Proof verified" << endl;
+	else
+		cout << fmt::format("Proof rejected: {}", checker.getError()) << endl;
+
+	if (trimmedProof)
+	{
+		unsigned long lemmaCount = isVerified ? checker.writeTrimmedProof(*trimmedProof) : 0;
+		trimmedProof->close();
+		if (isVerified)
+			cout << fmt::format("Derived clauses kept by trimming: {} of {}", lemmaCount, checker.getHintedLemmaCount() + checker.getPropagatedLemmaCount()) << endl;
+		else if (strcmp(trimmedProofPath, "-") != 0)
+			std::remove(trimmedProofPath);
+	}
+
+	cout << fmt::format("Derived clauses checked with hints: {}", checker.getHintedLemmaCount()) << endl;
+	cout << fmt::format("Derived clauses checked by unit propagation: {}", checker.getPropagatedLemmaCount()) << endl;
+	cout << fmt::format("Implicit clauses: {}", checker.getImplicitClauseCount()) << endl;
+	cout << fmt::format("Deleted clauses: {}", checker.getDeletedClauseCount()) << endl;
+	cout << fmt::format("Peak clause memory (bytes): {}", checker.getPeakClauseMemory()) << endl;
+	cout << fmt::format("Runtime (s): {:.3f}", chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count()) << endl;
+
+	return isVerified ? 0 : EXIT_CODE_REJECTED;
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Helper::registerSignalHandlers();
+		return parseAndCheck(argc, argv);
+	}
+	catch (Parser::ParserException const& ex)
+	{
+		cout << ex.what() << endl;
+		return EXIT_CODE_PARSING;
+	}
+	catch (Helper::SignalReceivedException const&)
+	{
+		return EXIT_CODE_SIGNALS;
+	}
+	catch (exception const& ex)
+	{
+		cout << fmt::format("An unexpected error occurred: {}", ex.what()) << endl;
+		return EXIT_CODE_UNEXPECTED;
+	}
+}
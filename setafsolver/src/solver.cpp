@@ -1,11 +1,16 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <map>
 
 #include "../header/tools/Helper.hpp"
 #include "../header/Solver.hpp"
+#include "../header/tools/Components.hpp"
+#include "../header/Preprocessor.hpp"
 
-Solver::Solver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, bool const& printModels, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ofstream>& proofFile) :
+template <typename Policy>
+Solver<Policy>::Solver(Instance& instance, Semantics const& semantics, Heuristics const& heuristics, chrono::time_point<chrono::high_resolution_clock>& firstModelTime, unsigned long& modelCount, double& percentageSolved, unsigned long& numberOfModels, ModelSink& modelSink, bool const& sccRecursive, double const& clForgetPercentage, double const& clGrowthRate, std::unique_ptr<ProofWriter>& proofFile) :
 	instance(instance),
 	semantics(semantics),
 	heuristics(heuristics),
@@ -13,16 +18,23 @@ Solver::Solver(Instance& instance, Semantics const& semantics, Heuristics const&
 	modelCount(modelCount),
 	percentageSolved(percentageSolved),
 	numberOfModels(numberOfModels),
-	printModels(printModels),
+	modelSink(modelSink),
+	printModels(modelSink.requiresModels()),
+	sccRecursive(sccRecursive),
 	learnedClausesToForgetThreshold(instance.getNumberOfArguments()),
 	clForgetPercentage(clForgetPercentage),
 	clGrowthRate(clGrowthRate),
-	proofFile(proofFile)
+	proofFile(proofFile),
+	implicitClause(numeric_limits<ID>::max(), Clause::ClauseType::Learned)
 {
 	assingedArguments.reserve(instance.getNumberOfArguments());
+	if constexpr (Policy::writesProof)
+		if (proofFile->hasHints())
+			isResolved.assign(instance.getNumberOfArguments(), false);
 };
 
-void Solver::solve()
+template <typename Policy>
+void Solver<Policy>::solve()
 {
 	switch (semantics.getType())
 	{
@@ -31,12 +43,41 @@ void Solver::solve()
 		break;
 	}
 
-	if (proofFile)
+	//The stability watches are only valid during the search, releasing them keeps the statistics exact if further instances are solved
+	for (ID i = 0; i < instance.getNumberOfArguments(); i++)
+		instance.getArgument(i).clearStabilityWatch();
+
+	if constexpr (Policy::writesProof)
 		if (modelCount == 0)
-			*proofFile << "0";
+			proofFile->writeEmptyClause();
+}
+
+template <typename Policy>
+void Solver<Policy>::setReconstruction(Preprocessor const* reconstruction)
+{
+	this->reconstruction = reconstruction;
+}
+
+template <typename Policy>
+void Solver<Policy>::setProbingBudget(unsigned long const& probingBudget)
+{
+	this->probingBudget = probingBudget;
+}
+
+template <typename Policy>
+void Solver<Policy>::setDetectEquivalences(bool const& detectEquivalences)
+{
+	this->detectEquivalences = detectEquivalences;
 }
 
-bool Solver::printAssignment()
+template <typename Policy>
+SearchStatistics const& Solver<Policy>::getStatistics() const
+{
+	return statistics;
+}
+
+template <typename Policy>
+bool Solver<Policy>::printAssignment()
 {
 	//Record the first model time 
 	if (modelCount == 0)
@@ -44,76 +85,132 @@ bool Solver::printAssignment()
 
 	modelCount++;
 
-	//Print the model
 	if (printModels)
 	{
-		printf("Model %lu\n", modelCount);
-		auto [begin, end] = instance.getArgumentsIterator();
-
-		//Print until the first argument which is in is found (thus the one without leading " ")
-		for (; begin != end; begin++)
+		modelArguments.clear();
+		for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
 		{
-			auto& argument = *begin;
-			assert(argument.getValueFast() != 0);
-			if (argument.getValueFast() == 1)
-			{
-				printf("%s", argument.getName().c_str());
-				begin++;
-				break;
-			}
+			assert(begin->getValueFast() != 0);
+			if (begin->getValueFast() == 1)
+				modelArguments.push_back(begin->getId());
 		}
 
-		//Print the remaining arguments with leading " "
-		for (; begin != end; begin++)
+		//Pass the model of the original instance
+		if (reconstruction != nullptr)
 		{
-			auto& argument = *begin;
-			assert(argument.getValueFast() != 0);
-			if (argument.getValueFast() == 1)
-				printf(" %s", argument.getName().c_str());
+			reconstruction->reconstructModel(modelArguments, originalModelArguments);
+			modelSink.addModel(modelCount, originalModelArguments);
 		}
-
-		printf("\n");
+		else
+			modelSink.addModel(modelCount, modelArguments);
 	}
 
 	return numberOfModels == modelCount;
 }
 
-void Solver::checkAndForgetClauses()
+template <typename Policy>
+void Solver<Policy>::checkAndForgetClauses()
 {
 	auto numberOfLearnedClauses = (double)instance.getNumberOfLearnedClauses();
+#ifdef STATISTICS
+	statistics.peakLearnedClauses = max(statistics.peakLearnedClauses, (unsigned long)numberOfLearnedClauses);
+#endif // STATISTICS
 	if (numberOfLearnedClauses > learnedClausesToForgetThreshold)
 	{
+#ifdef STATISTICS
+		statistics.forgottenClauses += (size_t)(numberOfLearnedClauses * clForgetPercentage);
+#endif // STATISTICS
 		if (modelCount == 0)
-			instance.forgetClauses(numberOfLearnedClauses * clForgetPercentage, proofFile, proofFile != nullptr);
+			instance.forgetClauses(numberOfLearnedClauses * clForgetPercentage, proofFile, Policy::writesProof);
 		else
 			instance.forgetClauses(numberOfLearnedClauses * clForgetPercentage, proofFile, false);
 		learnedClausesToForgetThreshold *= clGrowthRate;
 	}
 }
 
-void Solver::writeProofClause(Clause& clause, bool isImplicitClause)
+template <typename Policy>
+void Solver<Policy>::writeProofClause(Clause& clause, bool isImplicitClause)
+{
+	if (modelCount == 0)
+		proofFile->writeClause(isImplicitClause ? ProofWriter::LineKind::Implicit : ProofWriter::LineKind::Lemma, clause);
+}
+
+template <typename Policy>
+void Solver<Policy>::writeProofClause(vector<pair<Argument*, Sign>> const& literals, bool isImplicitClause)
+{
+	if (modelCount == 0)
+		proofFile->writeClause(isImplicitClause ? ProofWriter::LineKind::Implicit : ProofWriter::LineKind::Lemma, literals);
+}
+
+template <typename Policy>
+void Solver<Policy>::writeLearnedProofClause(Clause& learnedClause, Clause& conflictingClause, size_t numberOfResolvedArguments)
 {
+	if (&conflictingClause == &implicitClause)
+		isImplicitClauseResolved = true;
+
+	if (!proofFile->hasHints())
+	{
+		writeProofClause(learnedClause, false);
+		return;
+	}
+
+	//Under the negation of the learned clause, the reasons become unit in the order of the assignments, as every reason only contains arguments assigned before
+	proofHints.clear();
+	for (auto i = assingedArguments.size(); numberOfResolvedArguments != 0; )
+	{
+		auto argument = assingedArguments[--i];
+		if (!isResolved[argument->getId()])
+			continue;
+
+		isResolved[argument->getId()] = false;
+		numberOfResolvedArguments--;
+		proofHints.push_back(argument->getReason()->getProofId());
+	}
+	reverse(proofHints.begin(), proofHints.end());
+	proofHints.push_back(conflictingClause.getProofId());
+
+	//A clause that has not been written cannot be referenced, the learned clause is then checked by unit propagation
+	if (find(proofHints.begin(), proofHints.end(), 0) != proofHints.end())
+		proofHints.clear();
+
 	if (modelCount == 0)
+		proofFile->writeLemma(learnedClause, proofHints);
+}
+
+template <typename Policy>
+Clause& Solver<Policy>::buildImplictClause(Argument& arg)
+{
+	implicitClauseArgument = &arg;
+	implicitClauseHasLiterals = false;
+
+	if constexpr (Policy::writesProof)
 	{
-		if (isImplicitClause)
-			*proofFile << "i ";
+		//The clause of the previous stability conflict is deleted once it has been resolved. Otherwise it might justify an assignment at dl 0 or a failed probe
+		if (isImplicitClauseResolved && modelCount == 0)
+			proofFile->writeClause(ProofWriter::LineKind::Deletion, implicitClause);
+		isImplicitClauseResolved = false;
 
-		for (auto [beginMember, endMember] = clause.getMembersIterator(); beginMember != endMember; beginMember++)
+		//The proof requires the clause before it is used, also if the conflict is not analysed
+		if (modelCount == 0)
 		{
-			auto& [argument, sign] = *beginMember;
-			if (sign == -1)
-				*proofFile << "-";
-			*proofFile << argument->getName();
-			*proofFile << " ";
+			selectImplicitClauseLiterals();
+			writeProofClause(implicitClause, true);
 		}
-		*proofFile << "0\n";
 	}
+
+	return implicitClause;
 }
 
-Clause& Solver::buildImplictClause(Argument& arg)
+template <typename Policy>
+void Solver<Policy>::selectImplicitClauseLiterals()
 {
-	auto& clause = instance.getNewLearnedClause(arg.getAttackedByCount());
-	clause.addArgument(arg, 1);
+	if (implicitClauseHasLiterals)
+		return;
+
+	auto& arg = *implicitClauseArgument;
+	implicitClause.reset(Clause::ClauseType::Learned);
+	implicitClause.addUnwatchedArgument(arg, 1);
+	implicitClauseHasLiterals = true;
 
 	//Keep track of which arguments we have added so that we don't add them twice
 	helperHashsetID.clear();
@@ -142,29 +239,44 @@ Clause& Solver::buildImplictClause(Argument& arg)
 
 			assert(selectedArgument != nullptr);
 			if (helperHashsetID.insert(selectedArgument->getId()).second)
-				clause.addArgument(*selectedArgument, selectedArgument->getValueFast() * -1);
+				implicitClause.addUnwatchedArgument(*selectedArgument, selectedArgument->getValueFast() * -1);
 		}
 	}
 
 #ifdef TRACE
-	cout << "\tImplicit: " << clause.getId() << " {";
-	clause.printTrace();
+	cout << "\tImplicit: {";
+	implicitClause.printTrace();
 	cout << "}" << endl;
 #endif // TRACE
+}
 
-	if (proofFile)
-		writeProofClause(clause, true);
-
-
-	return clause;
+template <typename Policy>
+Clause& Solver<Policy>::materializeImplicitClause(Clause& clause)
+{
+	if (&clause != &implicitClause)
+		return clause;
+
+	//The clause becomes the reason of an assignment, thus it has to be watched like every learned clause
+	auto& learnedClause = instance.getNewLearnedClause(implicitClause.getMemberCount());
+	for (auto [begin, end] = implicitClause.getMembersIterator(); begin != end; begin++)
+		learnedClause.addArgument(*begin->first, begin->second);
+	learnedClause.setProofId(implicitClause.getProofId());
+#ifdef STATISTICS
+	statistics.learnedClauses++;
+	statistics.learnedLiterals += learnedClause.getMemberCount();
+#endif // STATISTICS
+	return learnedClause;
 }
 
-Clause* Solver::recomputeWatchedAttack(Argument& arg, size_t* const forAttackIndex)
+template <typename Policy>
+Clause* Solver<Policy>::recomputeWatchedAttack(Argument& arg, size_t* const forAttackIndex)
 {
 	//Note that we don't care if the arguments watched_attacked_index is still 0 due to initial assignment.
 	//In this case, we will set it here anyway or backtrack
 	//Otherwise, this attack will not be used again anyway as this method has been called exactly because this attack is no longer valid
 
+	assert(!Policy::usesStabilityCounters);
+
 	//Nothing to do if the argument it not currently out
 	if (arg.getValue(currentDl) != -1)
 		return nullptr;
@@ -187,10 +299,14 @@ Clause* Solver::recomputeWatchedAttack(Argument& arg, size_t* const forAttackInd
 			index = 0;
 	}
 
+#ifdef STATISTICS
+	statistics.stabilityRecomputations++;
+#endif // STATISTICS
 	do
 	{
 		auto& attack = arg.getAttackingClause(index);
-		if (attack.isNotBlocked(currentDl))
+		assert(isNotBlocked(attack) == attack.isNotBlocked(currentDl));
+		if (isNotBlocked(attack))
 		{
 			arg.setWatchedAttackedIndex(attack, index);
 			return nullptr;
@@ -205,7 +321,235 @@ Clause* Solver::recomputeWatchedAttack(Argument& arg, size_t* const forAttackInd
 	return &buildImplictClause(arg);
 }
 
-Clause* Solver::checkClause(Clause& clause, Argument* argument, bool* wasRemoved)
+template <typename Policy>
+void Solver<Policy>::initializeStabilityCounters()
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	//Attacks with the same supporting arguments share one support, such that its counter serves all of their targets
+	map<vector<ID>, ID> supportIds;
+	vector<vector<ID>> supportTargetLists;
+	vector<ID> support;
+	attackSupports.assign(instance.getNumberOfAttacks(), 0);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		if (begin->isSelfAttack())
+			continue;
+
+		support.clear();
+		auto [beginMember, endMember] = begin->getMembersIterator();
+		for (beginMember++; beginMember != endMember; beginMember++)
+			support.push_back(beginMember->first->getId());
+		sort(support.begin(), support.end());
+
+		auto [entry, isInserted] = supportIds.try_emplace(support, supportTargetLists.size());
+		if (isInserted)
+			supportTargetLists.emplace_back();
+		supportTargetLists[entry->second].push_back(begin->getAttackedArgument().getId());
+		attackSupports[begin->getId()] = entry->second;
+	}
+
+	auto numberOfSupports = supportTargetLists.size();
+	outSupportCounts.assign(numberOfSupports, 0);
+	supportTargetOffsets.assign(numberOfSupports + 1, 0);
+	supportsContainingOffsets.assign(numberOfArguments + 1, 0);
+	for (auto& [members, id] : supportIds)
+	{
+		supportTargetOffsets[id + 1] = supportTargetLists[id].size();
+		for (auto& member : members)
+		{
+			supportsContainingOffsets[member + 1]++;
+			if (instance.getArgument(member).getValueFast() == -1)
+				outSupportCounts[id]++;
+		}
+	}
+
+	for (size_t i = 0; i < numberOfSupports; i++)
+		supportTargetOffsets[i + 1] += supportTargetOffsets[i];
+	for (ID i = 0; i < numberOfArguments; i++)
+		supportsContainingOffsets[i + 1] += supportsContainingOffsets[i];
+
+	supportTargets.resize(supportTargetOffsets[numberOfSupports]);
+	supportsContaining.resize(supportsContainingOffsets[numberOfArguments]);
+	vector<size_t> fill(supportsContainingOffsets.begin(), supportsContainingOffsets.end() - 1);
+	for (auto& [members, id] : supportIds)
+	{
+		copy(supportTargetLists[id].begin(), supportTargetLists[id].end(), supportTargets.begin() + supportTargetOffsets[id]);
+		for (auto& member : members)
+			supportsContaining[fill[member]++] = id;
+	}
+
+	if constexpr (!Policy::usesStabilityCounters)
+		return;
+
+	unblockedAttackCounts.assign(numberOfArguments, 0);
+	for (size_t i = 0; i < numberOfSupports; i++)
+		if (outSupportCounts[i] == 0)
+			for (auto j = supportTargetOffsets[i]; j < supportTargetOffsets[i + 1]; j++)
+				unblockedAttackCounts[supportTargets[j]]++;
+
+	stabilityReasons.assign(numberOfArguments, Clause(numeric_limits<ID>::max(), Clause::ClauseType::Learned));
+	stabilityReasonArguments.assign(numberOfArguments, nullptr);
+	stabilityReasonHasLiterals.assign(numberOfArguments, false);
+	isSelectedForStabilityReason.assign(numberOfArguments, false);
+	assignmentPositions.assign(numberOfArguments, 0);
+}
+
+template <typename Policy>
+bool Solver<Policy>::isNotBlocked(Clause const& attack) const
+{
+	return !attack.isSelfAttack() && outSupportCounts[attackSupports[attack.getId()]] == 0;
+}
+
+template <typename Policy>
+void Solver<Policy>::blockSupportedAttacks(Argument& argument)
+{
+	auto id = argument.getId();
+	for (auto i = supportsContainingOffsets[id]; i < supportsContainingOffsets[id + 1]; i++)
+	{
+		auto support = supportsContaining[i];
+		if (outSupportCounts[support]++ != 0 || !Policy::usesStabilityCounters)
+			continue;
+
+		blockedSupports.push_back(support);
+		for (auto j = supportTargetOffsets[support]; j < supportTargetOffsets[support + 1]; j++)
+			unblockedAttackCounts[supportTargets[j]]--;
+	}
+}
+
+template <typename Policy>
+void Solver<Policy>::unblockSupportedAttacks(Argument& argument)
+{
+	auto id = argument.getId();
+	for (auto i = supportsContainingOffsets[id]; i < supportsContainingOffsets[id + 1]; i++)
+	{
+		auto support = supportsContaining[i];
+		if (--outSupportCounts[support] != 0 || !Policy::usesStabilityCounters)
+			continue;
+
+		for (auto j = supportTargetOffsets[support]; j < supportTargetOffsets[support + 1]; j++)
+			unblockedAttackCounts[supportTargets[j]]++;
+	}
+}
+
+template <typename Policy>
+Clause* Solver<Policy>::propagateStability(Argument& argument, size_t const& blockedSupportsBegin, size_t const& blockedSupportsEnd)
+{
+	//The supports are recorded when they are blocked, as further arguments of them might be out by the time their targets are checked. The assignments propagated
+	//meanwhile push above the range of this argument
+	auto conflict = enforceStability(argument);
+	for (auto i = blockedSupportsBegin; i < blockedSupportsEnd && conflict == nullptr; i++)
+	{
+		auto support = blockedSupports[i];
+		for (auto j = supportTargetOffsets[support]; j < supportTargetOffsets[support + 1] && conflict == nullptr; j++)
+		{
+			auto& target = instance.getArgument(supportTargets[j]);
+			if (target.getValueFast() == -1)
+				conflict = enforceStability(target);
+		}
+	}
+
+	blockedSupports.resize(blockedSupportsBegin);
+	return conflict;
+}
+
+template <typename Policy>
+Clause* Solver<Policy>::enforceStability(Argument& argument)
+{
+	auto count = unblockedAttackCounts[argument.getId()];
+	if (count == 0)
+		return &buildImplictClause(argument);
+	if (count > 1)
+		return nullptr;
+
+	for (auto [begin, end] = argument.getAttackedByIterator(); begin != end; begin++)
+	{
+		if (!isNotBlocked(**begin))
+			continue;
+
+		//The only unblocked attack has to defeat the argument. A supporting argument assigned out on the way blocks it, which is a conflict found by its propagation
+		auto [beginMember, endMember] = (*begin)->getMembersIterator();
+		for (beginMember++; beginMember != endMember; beginMember++)
+		{
+			auto& supportingArgument = *beginMember->first;
+			if (supportingArgument.getValueFast() != 0)
+				continue;
+
+			auto id = supportingArgument.getId();
+			auto& reason = stabilityReasons[id];
+			stabilityReasonArguments[id] = &argument;
+			stabilityReasonHasLiterals[id] = false;
+			if constexpr (Policy::writesProof)
+			{
+				//The proof requires the clause before it is used, as for the implicit clause. The previous one of this argument is not needed anymore
+				if (modelCount == 0)
+				{
+					if (reason.getProofId() != 0)
+						deleteStabilityReason(reason);
+					selectStabilityReasonLiterals(supportingArgument, assingedArguments.size());
+					writeProofClause(reason, true);
+				}
+			}
+
+			if (auto conflict = setAndPropagate(supportingArgument, 1, &reason); conflict != nullptr)
+				return conflict;
+		}
+		return nullptr;
+	}
+	return nullptr;
+}
+
+template <typename Policy>
+void Solver<Policy>::selectStabilityReasonLiterals(Argument& argument, size_t const& position)
+{
+	auto id = argument.getId();
+	if (stabilityReasonHasLiterals[id])
+		return;
+
+	auto& reason = stabilityReasons[id];
+	auto& outArgument = *stabilityReasonArguments[id];
+	reason.reset(Clause::ClauseType::Learned);
+	reason.addUnwatchedArgument(outArgument, 1);
+	reason.addUnwatchedArgument(argument, 1);
+	stabilityReasonHasLiterals[id] = true;
+
+	//The other attacks on the out argument were blocked when the argument was implied, thus by a supporting argument assigned before. Of these, one with the highest dl
+	//is selected, as for the implicit clause
+	for (auto [begin, end] = outArgument.getAttackedByIterator(); begin != end; begin++)
+	{
+		if ((*begin)->isSelfAttack())
+			continue;
+
+		Argument* selectedArgument = nullptr;
+		auto [beginMember, endMember] = (*begin)->getMembersIterator();
+		for (beginMember++; beginMember != endMember; beginMember++)
+		{
+			auto& supportingArgument = *beginMember->first;
+			if (&supportingArgument == &argument)
+			{
+				selectedArgument = &argument;
+				break;
+			}
+
+			if (supportingArgument.getValueFast() == -1 && assignmentPositions[supportingArgument.getId()] < position
+				&& (selectedArgument == nullptr || supportingArgument.getDl() > selectedArgument->getDl()))
+				selectedArgument = &supportingArgument;
+		}
+
+		assert(selectedArgument != nullptr);
+		if (selectedArgument != &argument && !isSelectedForStabilityReason[selectedArgument->getId()])
+		{
+			isSelectedForStabilityReason[selectedArgument->getId()] = true;
+			reason.addUnwatchedArgument(*selectedArgument, 1);
+		}
+	}
+
+	for (auto [begin, end] = reason.getMembersIterator(); begin != end; begin++)
+		isSelectedForStabilityReason[begin->first->getId()] = false;
+}
+
+template <typename Policy>
+Clause* Solver<Policy>::checkClause(Clause& clause, Argument* argument, bool* wasRemoved)
 {
 	//Unit clause are self attacks and should have been handled at dl 0 an thus should never occur here
 	assert(clause.getMemberCount() > 1 || !clause.isAttack());
@@ -214,6 +558,8 @@ Clause* Solver::checkClause(Clause& clause, Argument* argument, bool* wasRemoved
 	if (clause.isForgotten())
 	{
 		assert(argument != nullptr);
+		if (wasRemoved != nullptr)
+			*wasRemoved = true; //The caller has to check the clause swapped into its place
 		if (argument->removeWatchedIn(clause))
 			instance.recycleClause(clause);
 		return nullptr;
@@ -253,10 +599,12 @@ Clause* Solver::checkClause(Clause& clause, Argument* argument, bool* wasRemoved
 	}
 
 	//Update the watches of the clause if necessary
-	if (wasRemoved == nullptr)
-		clause.setWatch(start == clause.getFirstWatch(), watch);
-	else
-		*wasRemoved = clause.setWatch(start == clause.getFirstWatch(), watch);
+	bool isMoved = clause.setWatch(start == clause.getFirstWatch(), watch);
+	if (wasRemoved != nullptr)
+		*wasRemoved = isMoved;
+#ifdef STATISTICS
+	statistics.watchMoves += isMoved;
+#endif // STATISTICS
 
 	//If we checked the clause for a specific argument, we can end. Otherwise we need to check the other watch too
 	if (argument != nullptr)
@@ -266,7 +614,8 @@ Clause* Solver::checkClause(Clause& clause, Argument* argument, bool* wasRemoved
 	return checkClause(clause, clause.get_member_element_at(other)->first, wasRemoved);
 }
 
-Clause* Solver::setAndPropagate(Argument& argument, Sign value, Clause* reason)
+template <typename Policy>
+Clause* Solver<Policy>::setAndPropagate(Argument& argument, Sign value, Clause* reason)
 {
 	//If the argument already has a value set at a lower or equal decision level, we return the clause as conflicting
 	if (argument.getDl() <= currentDl)
@@ -279,8 +628,17 @@ Clause* Solver::setAndPropagate(Argument& argument, Sign value, Clause* reason)
 	}
 
 	//Do the assignment
+#ifdef STATISTICS
+	statistics.propagations++;
+#endif // STATISTICS
+	if constexpr (Policy::usesStabilityCounters)
+		assignmentPositions[argument.getId()] = assingedArguments.size();
 	assingedArguments.push_back(&argument);
 	argument.setValue(value, currentDl, reason, instance);
+	auto blockedSupportsBegin = blockedSupports.size();
+	if (value == -1)
+		blockSupportedAttacks(argument);
+	auto blockedSupportsEnd = blockedSupports.size();
 
 	//We check all the clauses in which the argument in watched in
 	//Cant use iterator as the list might change, as we might remove the current argument
@@ -304,15 +662,20 @@ Clause* Solver::setAndPropagate(Argument& argument, Sign value, Clause* reason)
 	if (value == 1)
 		return nullptr;
 
+	//The counters of the attacks blocked by this argument have been updated on assignment, thus a conflict or the last unblocked attack is found without searching
+	//for a new witness
+	if constexpr (Policy::usesStabilityCounters)
+		return propagateStability(argument, blockedSupportsBegin, blockedSupportsEnd);
+
 	//If we are here, value must be -1, thus we need to check stability
 	//Check all arguments for which this argument was used as guarantee for stability, as this argument is out and the resulting attack is blocked
 	while (!argument.stabilityWatchIsEmpty())
 	{
-		auto [stabilityArgument, index] = argument.stabilityWatchPop();
+		auto [stabilityArgument, index, position] = argument.stabilityWatchPop();
 		auto result = recomputeWatchedAttack(stabilityArgument, &index);
 		if (result != nullptr)
 		{
-			argument.stabilityWatchPush(stabilityArgument, index);
+			argument.stabilityWatchPush(stabilityArgument, index, position);
 			return result;
 		}
 	}
@@ -325,8 +688,17 @@ Clause* Solver::setAndPropagate(Argument& argument, Sign value, Clause* reason)
 	return nullptr;
 }
 
-Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument** uipArgument)
+template <typename Policy>
+Clause* Solver<Policy>::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument** uipArgument)
 {
+	//The literals of a stability conflict are only selected once it is analysed, which has to happen before the dl changes
+	if (&conflictingClause == &implicitClause)
+		selectImplicitClauseLiterals();
+
+#ifdef STATISTICS
+	statistics.conflicts++;
+#endif // STATISTICS
+
 	//Flipping caused conflict -> we dont analyse
 	if (currentDl == backjumpingBound)
 	{
@@ -336,7 +708,7 @@ Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument**
 		currentDl -= 1;
 		backjumpingBound = currentDl;
 		*uipArgument = nullptr;
-		return &conflictingClause;
+		return &materializeImplicitClause(conflictingClause);
 	}
 
 	//Find the second highest of the members of the clause		
@@ -367,7 +739,8 @@ Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument**
 			}
 			else
 			{
-				if (dl > secondHighestDl)
+				//numeric_limits<DL>::max() marks that no second highest dl has been found yet
+				if (secondHighestDl == numeric_limits<DL>::max() || dl > secondHighestDl)
 					secondHighestDl = dl;
 			}
 		}
@@ -391,11 +764,12 @@ Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument**
 	if (atMaxDL == 1)
 	{
 		currentDl = max(backjumpingBound, secondHighestDl);
-		return &conflictingClause;
+		return &materializeImplicitClause(conflictingClause);
 	}
 
-	//Build the learned clause
+	//Build the learned clause. The resolved arguments are only marked if the proof has hints
 	auto& learnedClause = instance.getNewLearnedClause(1);
+	size_t numberOfResolvedArguments = 0;
 	helperVectorArgumentSign.clear();
 	helperHashsetID.clear(); //Used to keep track of which arguments we have already added to avoid duplicates
 
@@ -434,11 +808,20 @@ Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument**
 
 		auto& argument = entry->first;
 		assert(argument->getReason() != nullptr);
+		if constexpr (Policy::writesProof)
+			if (!isResolved.empty() && !isResolved[argument->getId()])
+			{
+				isResolved[argument->getId()] = true;
+				numberOfResolvedArguments++;
+			}
 		//TODO: careful for shared clauses, they might have 2 arguments with only guesses. Return conflicting clause?
 
 		//We now replace the arg with the members of its reason		
 		helperHashsetID.erase(argument->getId());
 		auto reason = argument->getReason();
+		if constexpr (Policy::usesStabilityCounters)
+			if (reason == &stabilityReasons[argument->getId()])
+				selectStabilityReasonLiterals(*argument, assignmentPositions[argument->getId()]);
 		for (auto [memberCount, i] = pair(reason->getMemberCount(), (size_t)0); i < memberCount; i++)
 		{
 			auto reasonMember = reason->get_member_element_at(i);
@@ -475,20 +858,26 @@ Clause* Solver::resolveConflictAndUpdateDL(Clause& conflictingClause, Argument**
 	}
 	currentDl = max(backjumpingBound, secondHighestDl);
 
+#ifdef STATISTICS
+	statistics.learnedClauses++;
+	statistics.learnedLiterals += learnedClause.getMemberCount();
+#endif // STATISTICS
+
 #ifdef TRACE
 	cout << "\tLearned: " << learnedClause.getId() << " {";
 	learnedClause.printTrace();
 	cout << "}" << endl;
 #endif // TRACE
 
-	if (proofFile)
-		writeProofClause(learnedClause, false);
+	if constexpr (Policy::writesProof)
+		writeLearnedProofClause(learnedClause, conflictingClause, numberOfResolvedArguments);
 
 	return &learnedClause;
 }
 
 
-bool Solver::backtrackForClause(Clause& conflictingClause)
+template <typename Policy>
+bool Solver<Policy>::backtrackForClause(Clause& conflictingClause)
 {
 	auto clause = &conflictingClause;
 	Argument* resultingArgument = nullptr;
@@ -503,6 +892,11 @@ bool Solver::backtrackForClause(Clause& conflictingClause)
 
 		if (prevDL != currentDl)
 		{
+#ifdef STATISTICS
+			statistics.backjumps++;
+			statistics.backjumpDistance += prevDL - currentDl;
+			statistics.maximumBackjumpDistance = max(statistics.maximumBackjumpDistance, prevDL - currentDl);
+#endif // STATISTICS
 			if (resultingArgument == nullptr)
 			{
 				//Need to flip decision literal
@@ -528,7 +922,8 @@ bool Solver::backtrackForClause(Clause& conflictingClause)
 	return true;
 }
 
-Argument* Solver::backtrackToCurrentDL(Sign& oldSign)
+template <typename Policy>
+Argument* Solver<Policy>::backtrackToCurrentDL(Sign& oldSign)
 {
 #ifdef TRACE		
 	cout << "\tBacktrack to dl " << currentDl << endl;
@@ -536,12 +931,17 @@ Argument* Solver::backtrackToCurrentDL(Sign& oldSign)
 
 	assert(!assingedArguments.empty());
 
+	//The assignments that ended in a conflict did not remove their blocked supports
+	blockedSupports.clear();
+
 	//Undo all guesses until we reach the decision literal for the destination dl		
 	Argument* argument = nullptr;
 	while (!assingedArguments.empty() && assingedArguments.back()->getDl() > currentDl)
 	{
 		argument = assingedArguments.back();
 		oldSign = argument->getValueFast();
+		if (oldSign == -1)
+			unblockSupportedAttacks(*argument);
 		argument->reset();
 		nextGuessPosition = min(nextGuessPosition, argument->getPosition());
 		assingedArguments.pop_back();
@@ -551,7 +951,8 @@ Argument* Solver::backtrackToCurrentDL(Sign& oldSign)
 }
 
 
-bool Solver::computeGrounded()
+template <typename Policy>
+bool Solver<Policy>::computeGrounded()
 {
 	//Contains, for each attack, either Nothing if the attack is blocked (= some supporting argument is set to -1) or the number of supporting arguments that are not yet set to 1 and the attack argument
 	vector<pair<optional<size_t>, Argument*>> attacks;
@@ -601,6 +1002,11 @@ bool Solver::computeGrounded()
 		}
 	}
 
+	//The arguments that are already in have been taken into account by the counts above
+	vector<bool> isCounted(instance.getNumberOfArguments(), false);
+	for (auto& argument : assingedArguments)
+		isCounted[argument->getId()] = argument->getValueFast() == 1;
+
 	//The arguments that we need to assigned with either the reason why we must set them -1 or nullptr if we need to set them 1
 	vector<tuple<Argument*, Clause*>> argsToDo;
 
@@ -625,13 +1031,16 @@ bool Solver::computeGrounded()
 
 		Sign sign = reason == nullptr ? 1 : -1;
 
-		if (proofFile)
+		if constexpr (Policy::writesProof)
 			if (argument->getValue(0) == 0)
 				buildImplictClause(*argument);
 
 		if (setAndPropagate(*argument, sign, reason) != nullptr)
 			return false; //Assignment caused a conflict
 
+		if (isCounted[argument->getId()])
+			continue;
+
 		//Check all attacks that contain the argument
 		for (auto& attack : containedInAsAttacker[argument->getId()])
 		{
@@ -659,7 +1068,136 @@ bool Solver::computeGrounded()
 	return true;
 }
 
-bool Solver::doAssignment(Argument& argument, Sign sign, Clause* reason)
+template <typename Policy>
+bool Solver<Policy>::probe()
+{
+	auto budget = probingBudget;
+	vector<pair<Argument*, Sign>> impliedByIn, impliedByOut, unitClause(1), lemma(2);
+	vector<Sign> valueByIn(instance.getNumberOfArguments(), 0);
+	bool hasChanged = true;
+
+	//The second value of an argument might imply an argument again that the first value implied by a stability reason, which is then replaced. The lemmas of the
+	//argument follow from the reasons of both values, thus the replaced ones are deleted after the lemmas have been written
+	isProbing = true;
+	while (hasChanged && budget != 0)
+	{
+		hasChanged = false;
+		for (auto [begin, end] = instance.getArgumentsIterator(); begin != end && budget != 0; begin++)
+		{
+			if (Helper::receivedSignal())
+				break;
+
+			auto& argument = *begin;
+			if (argument.getValueFast() != 0)
+				continue;
+
+			//A failed value is never part of an extension, thus the other value is asserted
+			bool inFailed = probeValue(argument, 1, impliedByIn, budget);
+			bool outFailed = !inFailed && probeValue(argument, -1, impliedByOut, budget);
+			if (inFailed || outFailed)
+			{
+				unitClause[0] = pair(&argument, inFailed ? -1 : 1);
+				if constexpr (Policy::writesProof)
+				{
+					writeProofClause(unitClause, false);
+					writeDeferredReasonDeletions();
+				}
+				if (setAndPropagate(argument, unitClause[0].second, nullptr) != nullptr)
+					return false;
+
+				hasChanged = true;
+				continue;
+			}
+
+			//Assignments implied by both values hold in every extension. The lemmas for both values make the unit clause derivable by unit propagation
+			for (auto& [implied, sign] : impliedByIn)
+				valueByIn[implied->getId()] = sign;
+			for (auto& [implied, sign] : impliedByOut)
+			{
+				if (valueByIn[implied->getId()] != sign || implied->getValueFast() != 0)
+					continue;
+
+				if constexpr (Policy::writesProof)
+				{
+					unitClause[0] = pair(implied, sign);
+					lemma[0] = pair(&argument, -1);
+					lemma[1] = unitClause[0];
+					writeProofClause(lemma, false);
+					lemma[0] = pair(&argument, 1);
+					writeProofClause(lemma, false);
+					writeProofClause(unitClause, false);
+				}
+				if (setAndPropagate(*implied, sign, nullptr) != nullptr)
+					return false;
+
+				hasChanged = true;
+			}
+			for (auto& [implied, sign] : impliedByIn)
+				valueByIn[implied->getId()] = 0;
+			if constexpr (Policy::writesProof)
+				writeDeferredReasonDeletions();
+		}
+	}
+
+	isProbing = false;
+	if constexpr (Policy::writesProof)
+		writeDeferredReasonDeletions();
+	return true;
+}
+
+template <typename Policy>
+bool Solver<Policy>::probeValue(Argument& argument, Sign const& value, vector<pair<Argument*, Sign>>& implied, unsigned long& budget)
+{
+	auto trailPosition = assingedArguments.size();
+	currentDl = 1;
+	bool hasFailed = setAndPropagate(argument, value, nullptr) != nullptr;
+
+	implied.clear();
+	for (auto i = trailPosition + 1; i < assingedArguments.size(); i++)
+		implied.emplace_back(assingedArguments[i], assingedArguments[i]->getValueFast());
+	budget -= min<unsigned long>(budget, assingedArguments.size() - trailPosition);
+
+	currentDl = 0;
+	Sign oldSign;
+	backtrackToCurrentDL(oldSign);
+	return hasFailed;
+}
+
+template <typename Policy>
+void Solver<Policy>::deleteStabilityReason(Clause& reason)
+{
+	if (!isProbing)
+	{
+		proofFile->writeClause(ProofWriter::LineKind::Deletion, reason);
+		return;
+	}
+
+	auto [begin, end] = reason.getMembersIterator();
+	deferredReasonDeletions.emplace_back(reason.getProofId(), vector<pair<Argument*, Sign>>(begin, end));
+}
+
+template <typename Policy>
+void Solver<Policy>::writeDeferredReasonDeletions()
+{
+	if (deferredReasonDeletions.empty())
+		return;
+
+	//With hints, the clauses are deleted by their numbers in a single line
+	if (proofFile->hasHints())
+	{
+		proofHints.clear();
+		for (auto& [proofId, literals] : deferredReasonDeletions)
+			proofHints.push_back(proofId);
+		proofFile->writeDeletion(proofHints);
+	}
+	else
+		for (auto& [proofId, literals] : deferredReasonDeletions)
+			proofFile->writeClause(ProofWriter::LineKind::Deletion, literals);
+	deferredReasonDeletions.clear();
+}
+
+template <typename Policy>
+bool Solver<Policy>::doAssignment(Argument& argument, Sign sign, Clause* reason)
 {
 	auto result = setAndPropagate(argument, sign, reason);
 	if (result == nullptr)
@@ -673,7 +1211,8 @@ bool Solver::doAssignment(Argument& argument, Sign sign, Clause* reason)
 }
 
 
-double Solver::calculate_stable()
+template <typename Policy>
+double Solver<Policy>::calculate_stable()
 {
 	//If we have 0 arguments, there is only the empty set
 	if (instance.getNumberOfArguments() == 0)
@@ -682,6 +1221,8 @@ double Solver::calculate_stable()
 		return 1.0;
 	}
 
+	initializeStabilityCounters();
+
 	//We do at dl 0 all signed that are forced
 	//Argument that have incoming attacks that are only contain themselves are out
 	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
@@ -701,8 +1242,21 @@ double Solver::calculate_stable()
 	if (!computeGrounded())
 		return 1.0;
 
+	//Probing might fix further arguments, from which the grounded extension might grow
+	if (probingBudget != 0)
+	{
+		auto numberOfAssigned = assingedArguments.size();
+		if (!probe() || (assingedArguments.size() != numberOfAssigned && !computeGrounded()))
+			return 1.0;
+	}
+
 	//Apply heuristics
 	auto [sortedArguments, guessOrder] = heuristics.apply(instance, currentDl);
+	if (sccRecursive)
+		orderByStronglyConnectedComponents(sortedArguments, guessOrder);
+	deferSinkArguments(sortedArguments, guessOrder);
+	if (detectEquivalences && !deferEquivalentArguments(sortedArguments, guessOrder))
+		return 1.0;
 
 	//Start guessing
 	while (true)
@@ -714,10 +1268,20 @@ double Solver::calculate_stable()
 
 		if (nextGuessPosition == sortedArguments.size())
 		{
+			//The deferred arguments follow from the guessed ones
+			if (auto conflict = assignDeferredArguments(); conflict != nullptr)
+			{
+				if (!backtrackForClause(*conflict))
+					return 1.0;
+				continue;
+			}
+
 			//We have a full assignment
 			if (printAssignment())
-				calculatePercentageSolved(sortedArguments, guessOrder); //Required number of models found
+				return calculatePercentageSolved(sortedArguments, guessOrder); //Required number of models found
 
+			//The deferred arguments are determined by the guessed ones, thus the last guess is flipped
+			currentDl = getLastGuessDl();
 			if (currentDl == 0)
 				return 1.0; //No further backtracking possible			
 
@@ -741,14 +1305,281 @@ double Solver::calculate_stable()
 
 		//Guess for the current argument
 		currentDl++;
+#ifdef STATISTICS
+		statistics.decisions++;
+#endif // STATISTICS
 		if (!doAssignment(*argument, guessOrder[nextGuessPosition], nullptr))
 			return 1.0;
 	}
 	return 1.0;
 }
 
+template <typename Policy>
+void Solver<Policy>::orderByStronglyConnectedComponents(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder)
+{
+	ID numberOfComponents;
+	auto componentOfArgument = Components::computeStronglyConnected(instance, numberOfComponents);
 
-double Solver::calculatePercentageSolved(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder)
+	//Stable sort by component, such that the heuristics order is retained within a component
+	vector<pair<Argument*, Sign>> guesses;
+	guesses.reserve(sortedArguments.size());
+	for (ID i = 0; i < sortedArguments.size(); i++)
+		guesses.emplace_back(sortedArguments[i], guessOrder[i]);
+
+	stable_sort(guesses.begin(), guesses.end(),
+		[&](pair<Argument*, Sign> const& first, pair<Argument*, Sign> const& second) { return componentOfArgument[first.first->getId()] < componentOfArgument[second.first->getId()]; });
+
+	//Write back and update the positions
+	for (ID i = 0; i < guesses.size(); i++)
+	{
+		sortedArguments[i] = guesses[i].first;
+		guessOrder[i] = guesses[i].second;
+		sortedArguments[i]->setPosition(i);
+	}
+}
+
+template <typename Policy>
+void Solver<Policy>::deferSinkArguments(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder)
+{
+	//An attack constrains its supporting arguments unless it is blocked at dl 0, i.e. a supporting argument is out. If only the attacked argument is out, the attack
+	//might be the one that defeats it, thus its supporting arguments are still constrained. The attacked argument of a self attack is its only supporting argument
+	auto isBlocked = [](Clause& attack)
+	{
+		auto [begin, end] = attack.getMembersIterator();
+		if (attack.isSelfAttack())
+			return begin->first->getValueFast() == -1;
+		return any_of(begin + 1, end, [](pair<Argument*, Sign> const& member) { return member.first->getValueFast() == -1; });
+	};
+
+	//For each argument, the number of attacks that constrain it and whose attacked argument has not been deferred
+	vector<ID> supportCount(instance.getNumberOfArguments(), 0);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		if (isBlocked(*begin))
+			continue;
+
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		if (begin->isSelfAttack())
+			supportCount[memberBegin->first->getId()]++;
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			supportCount[memberBegin->first->getId()]++;
+	}
+
+	vector<bool> isDeferred(instance.getNumberOfArguments(), false);
+	for (auto& argument : sortedArguments)
+		if (supportCount[argument->getId()] == 0)
+		{
+			isDeferred[argument->getId()] = true;
+			deferredArguments.push_back(argument);
+		}
+
+	//Deferring an argument releases the supporting arguments of the attacks on it
+	for (size_t next = 0; next < deferredArguments.size(); next++)
+		for (auto [begin, end] = deferredArguments[next]->getAttackedByIterator(); begin != end; begin++)
+		{
+			if (isBlocked(**begin))
+				continue;
+
+			auto [memberBegin, memberEnd] = (*begin)->getMembersIterator();
+			for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			{
+				auto& member = *memberBegin->first;
+				if (--supportCount[member.getId()] == 0 && member.getValueFast() == 0)
+				{
+					isDeferred[member.getId()] = true;
+					deferredArguments.push_back(&member);
+				}
+			}
+		}
+
+	//The arguments deferred last are assigned first, as the deferred arguments attacked by them depend on them
+	reverse(deferredArguments.begin(), deferredArguments.end());
+
+	removeFromGuessOrder(sortedArguments, guessOrder, isDeferred);
+}
+
+template <typename Policy>
+bool Solver<Policy>::deferEquivalentArguments(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder)
+{
+	//The literal of an argument being in has the index 2 * id, the one of it being out 2 * id + 1
+	auto numberOfArguments = instance.getNumberOfArguments();
+	auto literal = [](ID const& id, Sign const& sign) { return 2 * id + (sign == 1 ? 0 : 1); };
+	vector<bool> isGuessed(numberOfArguments, false);
+	for (auto& argument : sortedArguments)
+		isGuessed[argument->getId()] = true;
+
+	//A binary clause (a or b) implies b if a is false and vice versa
+	vector<vector<ID>> implications(2 * numberOfArguments);
+	auto addBinaryClause = [&](pair<Argument*, Sign> const& first, pair<Argument*, Sign> const& second)
+	{
+		implications[literal(first.first->getId(), -first.second)].push_back(literal(second.first->getId(), second.second));
+		implications[literal(second.first->getId(), -second.second)].push_back(literal(first.first->getId(), first.second));
+	};
+
+	//Attacks that are not satisfied at dl 0 and have exactly two members that are not false
+	vector<pair<Argument*, Sign>> openMembers;
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		openMembers.clear();
+		bool isUsable = true;
+		for (auto [memberBegin, memberEnd] = begin->getMembersIterator(); memberBegin != memberEnd && isUsable; memberBegin++)
+		{
+			auto& [argument, sign] = *memberBegin;
+			if (argument->getValueFast() == sign || (argument->getValueFast() == 0 && !isGuessed[argument->getId()]))
+				isUsable = false;
+			else if (argument->getValueFast() == 0)
+				openMembers.push_back(*memberBegin);
+		}
+
+		if (isUsable && openMembers.size() == 2)
+			addBinaryClause(openMembers[0], openMembers[1]);
+	}
+
+	//An argument with a single unblocked attack with a single supporting argument that is not in is in or that argument is
+	for (auto& argument : sortedArguments)
+	{
+		Clause* witness = nullptr;
+		bool isSingle = true;
+		for (auto [begin, end] = argument->getAttackedByIterator(); begin != end && isSingle; begin++)
+			if ((*begin)->isNotBlocked(0))
+			{
+				isSingle = witness == nullptr;
+				witness = *begin;
+			}
+		if (witness == nullptr || !isSingle)
+			continue;
+
+		openMembers.clear();
+		auto [memberBegin, memberEnd] = witness->getMembersIterator();
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			if (memberBegin->first->getValueFast() == 0)
+				openMembers.push_back(*memberBegin);
+		if (openMembers.size() != 1 || !isGuessed[openMembers[0].first->getId()])
+			continue;
+
+		auto supporter = openMembers[0].first;
+		auto& clause = instance.getNewPermanentClause(2);
+		clause.addArgument(*argument, 1);
+		clause.addArgument(*supporter, 1);
+		if constexpr (Policy::writesProof)
+		{
+			//The clause follows from the implicit clause of the argument, as the other attacks are blocked at dl 0
+			openMembers.clear();
+			openMembers.emplace_back(argument, 1);
+			for (auto [begin, end] = argument->getAttackedByIterator(); begin != end; begin++)
+			{
+				if ((*begin)->isSelfAttack())
+					continue;
+
+				if (*begin == witness)
+				{
+					openMembers.emplace_back(supporter, 1);
+					continue;
+				}
+
+				auto [blockingBegin, blockingEnd] = (*begin)->getMembersIterator();
+				auto blocking = find_if(blockingBegin + 1, blockingEnd, [](pair<Argument*, Sign> const& member) { return member.first->getValueFast() == -1; });
+				openMembers.emplace_back(blocking->first, 1);
+			}
+			writeProofClause(openMembers, true);
+			writeProofClause(clause, false);
+		}
+		addBinaryClause(*clause.get_member_element_at(0), *clause.get_member_element_at(1));
+	}
+
+	ID numberOfComponents;
+	auto componentOfLiteral = Components::computeStronglyConnected(implications, numberOfComponents);
+
+	//The representative of a component is its literal with the lowest index, the component of the negated literals has the negated representative
+	const ID none = numeric_limits<ID>::max();
+	vector<ID> representativeOfComponent(numberOfComponents, none);
+	for (ID i = 0; i < 2 * numberOfArguments; i++)
+		if (representativeOfComponent[componentOfLiteral[i]] == none)
+			representativeOfComponent[componentOfLiteral[i]] = i;
+
+	vector<bool> isEquivalent(numberOfArguments, false);
+	vector<Argument*> equivalentArguments;
+	for (auto& argument : sortedArguments)
+	{
+		auto id = argument->getId();
+		if (componentOfLiteral[literal(id, 1)] == componentOfLiteral[literal(id, -1)])
+		{
+			//Both values imply each other, thus the argument can neither be in nor out
+			if constexpr (Policy::writesProof)
+			{
+				vector<pair<Argument*, Sign>> unitClause{ pair(argument, -1) };
+				writeProofClause(unitClause, false);
+				unitClause[0].second = 1;
+				writeProofClause(unitClause, false);
+			}
+			return false;
+		}
+
+		if (representativeOfComponent[componentOfLiteral[literal(id, 1)]] / 2 != id)
+		{
+			isEquivalent[id] = true;
+			equivalentArguments.push_back(argument);
+		}
+	}
+
+	//The equivalent arguments are assigned by propagation before any deferred argument could depend on them
+	deferredArguments.insert(deferredArguments.begin(), equivalentArguments.begin(), equivalentArguments.end());
+	removeFromGuessOrder(sortedArguments, guessOrder, isEquivalent);
+	return true;
+}
+
+template <typename Policy>
+void Solver<Policy>::removeFromGuessOrder(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder, vector<bool> const& isRemoved)
+{
+	ID remaining = 0;
+	for (ID i = 0; i < sortedArguments.size(); i++)
+	{
+		if (isRemoved[sortedArguments[i]->getId()])
+		{
+			sortedArguments[i]->setPosition(numeric_limits<ID>::max());
+			continue;
+		}
+
+		sortedArguments[remaining] = sortedArguments[i];
+		guessOrder[remaining] = guessOrder[i];
+		sortedArguments[remaining]->setPosition(remaining);
+		remaining++;
+	}
+	sortedArguments.resize(remaining);
+	guessOrder.resize(remaining);
+}
+
+template <typename Policy>
+Clause* Solver<Policy>::assignDeferredArguments()
+{
+	//If an attack on a deferred argument had all its supporting arguments in, the argument would have been set out by propagation.
+	//Every deferred argument is assigned at its own dl, such that the highest dl of a conflict contains a single assignment without reason
+	for (auto& argument : deferredArguments)
+		if (argument->getValueFast() == 0)
+		{
+			currentDl++;
+			if (auto conflict = setAndPropagate(*argument, 1, nullptr); conflict != nullptr)
+				return conflict;
+		}
+
+	return nullptr;
+}
+
+template <typename Policy>
+DL Solver<Policy>::getLastGuessDl() const
+{
+	//Guessed arguments have a position in the guess order, deferred ones do not
+	for (auto i = assingedArguments.size(); i-- > 0;)
+	{
+		auto argument = assingedArguments[i];
+		if (argument->getReason() == nullptr && argument->getPosition() != numeric_limits<ID>::max())
+			return argument->getDl();
+	}
+	return 0;
+}
+
+template <typename Policy>
+double Solver<Policy>::calculatePercentageSolved(vector<Argument*>& sortedArguments, vector<Sign>& guessOrder)
 {
 	double percentageSolved = 0;
 	for (ID i = 0; i < sortedArguments.size(); i++)
@@ -757,4 +1588,9 @@ double Solver::calculatePercentageSolved(vector<Argument*>& sortedArguments, vec
 			percentageSolved += pow(0.5, i + 1);
 	}
 	return percentageSolved;
-}
\ No newline at end of file
+}
+
+template class Solver<SolverPolicy<false, false>>;
+template class Solver<SolverPolicy<false, true>>;
+template class Solver<SolverPolicy<true, false>>;
+template class Solver<SolverPolicy<true, true>>;
@@ -0,0 +1,135 @@
+#include "../../header/tools/AsyncModelSink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+optional<AsyncModelSink::Backpressure> AsyncModelSink::tryParseBackpressure(char const* s)
+{
+	if (strcmp(s, "Block") == 0)
+		return Backpressure::Block;
+
+	if (strcmp(s, "Drop") == 0)
+		return Backpressure::Drop;
+
+	return {};
+}
+
+AsyncModelSink::AsyncModelSink(unique_ptr<ModelSink> sink, size_t const& numberOfArguments, Backpressure const& backpressure, unsigned long& waitCount, double& waitSeconds, unsigned long& droppedModelCount) :
+	sink(std::move(sink)),
+	backpressure(backpressure),
+	waitCount(waitCount),
+	waitSeconds(waitSeconds),
+	droppedModelCount(droppedModelCount)
+{
+	slotCount = clamp(slotMemory / max<size_t>(1, numberOfArguments * sizeof(ID)), (size_t)2, maximumSlotCount);
+	slotArguments.resize(slotCount);
+	for (auto& arguments : slotArguments)
+		arguments.reserve(numberOfArguments);
+	slotModelNumbers.resize(slotCount);
+
+	writer = thread(&AsyncModelSink::writeModels, this);
+}
+
+AsyncModelSink::~AsyncModelSink()
+{
+	isClosing.store(true);
+	{
+		lock_guard<mutex> lock(sleepMutex);
+		modelAdded.notify_one();
+	}
+	writer.join();
+}
+
+void AsyncModelSink::addModel(unsigned long const& modelNumber, vector<ID> const& inArguments)
+{
+	auto position = tail.load(memory_order_relaxed);
+	if (position - head.load(memory_order_acquire) == slotCount)
+	{
+		if (backpressure == Backpressure::Drop)
+		{
+			droppedModelCount++;
+			return;
+		}
+
+		//Waiting for half of the slots avoids switching between the threads for every model
+		auto startTime = chrono::high_resolution_clock::now();
+		waitForFreeSlots(slotCount / 2);
+		waitCount++;
+		waitSeconds += chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+	}
+
+	auto slot = position % slotCount;
+	slotArguments[slot].assign(inArguments.begin(), inArguments.end());
+	slotModelNumbers[slot] = modelNumber;
+	tail.store(position + 1);
+
+	//The writing thread announces that it sleeps before it checks the ring buffer a last time, thus either it sees the model or it is woken up
+	if (isWriterSleeping.load())
+	{
+		lock_guard<mutex> lock(sleepMutex);
+		modelAdded.notify_one();
+	}
+}
+
+void AsyncModelSink::flush()
+{
+	waitForFreeSlots(slotCount);
+	sink->flush();
+}
+
+void AsyncModelSink::waitForFreeSlots(size_t const& freeSlots)
+{
+	auto hasFreeSlots = [&] { return slotCount - (tail.load(memory_order_relaxed) - head.load()) >= freeSlots; };
+	for (unsigned i = 0; i < spinCount && !hasFreeSlots(); i++)
+		this_thread::yield();
+
+	if (hasFreeSlots())
+		return;
+
+	unique_lock<mutex> lock(sleepMutex);
+	isSearchSleeping.store(true);
+	slotFreed.wait(lock, hasFreeSlots);
+	isSearchSleeping.store(false);
+}
+
+void AsyncModelSink::writeModels()
+{
+	while (true)
+	{
+		auto position = head.load(memory_order_relaxed);
+		if (position == tail.load())
+		{
+			//The search thread adds no model after closing, thus the ring buffer stays empty
+			if (isClosing.load())
+			{
+				if (position == tail.load())
+					return;
+				continue;
+			}
+
+			auto hasModel = [&] { return position != tail.load() || isClosing.load(); };
+			for (unsigned i = 0; i < spinCount && !hasModel(); i++)
+				this_thread::yield();
+
+			if (!hasModel())
+			{
+				unique_lock<mutex> lock(sleepMutex);
+				isWriterSleeping.store(true);
+				modelAdded.wait(lock, hasModel);
+				isWriterSleeping.store(false);
+			}
+			continue;
+		}
+
+		auto slot = position % slotCount;
+		sink->addModel(slotModelNumbers[slot], slotArguments[slot]);
+		head.store(position + 1);
+
+		if (isSearchSleeping.load())
+		{
+			lock_guard<mutex> lock(sleepMutex);
+			slotFreed.notify_one();
+		}
+	}
+}
@@ -0,0 +1,132 @@
+#include "../../header/tools/BigUnsigned.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+BigUnsigned::BigUnsigned(unsigned long const& value)
+{
+	for (auto remaining = value; remaining != 0; remaining >>= 32)
+		limbs.push_back((uint32_t)remaining);
+}
+
+void BigUnsigned::trim()
+{
+	while (!limbs.empty() && limbs.back() == 0)
+		limbs.pop_back();
+}
+
+BigUnsigned& BigUnsigned::operator+=(BigUnsigned const& other)
+{
+	if (limbs.size() < other.limbs.size())
+		limbs.resize(other.limbs.size(), 0);
+
+	uint64_t carry = 0;
+	for (size_t i = 0; i < limbs.size(); i++)
+	{
+		uint64_t sum = (uint64_t)limbs[i] + carry + (i < other.limbs.size() ? other.limbs[i] : 0);
+		limbs[i] = (uint32_t)sum;
+		carry = sum >> 32;
+		if (carry == 0 && i >= other.limbs.size())
+			break;
+	}
+
+	if (carry != 0)
+		limbs.push_back((uint32_t)carry);
+
+	return *this;
+}
+
+BigUnsigned& BigUnsigned::operator*=(BigUnsigned const& other)
+{
+	if (isZero() || other.isZero())
+	{
+		limbs.clear();
+		return *this;
+	}
+
+	//Schoolbook multiplication, the values are products of model counts and thus stay small compared to where faster methods pay off
+	vector<uint32_t> result(limbs.size() + other.limbs.size(), 0);
+	for (size_t i = 0; i < limbs.size(); i++)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; j < other.limbs.size(); j++)
+		{
+			uint64_t product = (uint64_t)limbs[i] * other.limbs[j] + result[i + j] + carry;
+			result[i + j] = (uint32_t)product;
+			carry = product >> 32;
+		}
+		result[i + other.limbs.size()] = (uint32_t)carry;
+	}
+
+	limbs = std::move(result);
+	trim();
+	return *this;
+}
+
+bool BigUnsigned::operator==(BigUnsigned const& other) const
+{
+	return limbs == other.limbs;
+}
+
+bool BigUnsigned::operator<(BigUnsigned const& other) const
+{
+	if (limbs.size() != other.limbs.size())
+		return limbs.size() < other.limbs.size();
+	return lexicographical_compare(limbs.rbegin(), limbs.rend(), other.limbs.rbegin(), other.limbs.rend());
+}
+
+bool BigUnsigned::isZero() const
+{
+	return limbs.empty();
+}
+
+unsigned long BigUnsigned::toULongSaturated() const
+{
+	if (limbs.size() * 32 > (size_t)numeric_limits<unsigned long>::digits)
+		return numeric_limits<unsigned long>::max();
+
+	unsigned long value = 0;
+	for (auto it = limbs.rbegin(); it != limbs.rend(); it++)
+		value = (value << 32) | *it;
+	return value;
+}
+
+double BigUnsigned::toDouble() const
+{
+	double value = 0;
+	for (auto it = limbs.rbegin(); it != limbs.rend(); it++)
+		value = value * 4294967296.0 + *it;
+	return value;
+}
+
+string BigUnsigned::toString() const
+{
+	if (isZero())
+		return "0";
+
+	//Repeatedly divide by 10^9 and collect the remainders as blocks of 9 digits
+	vector<uint32_t> remaining = limbs;
+	vector<uint32_t> blocks;
+	while (!remaining.empty())
+	{
+		uint64_t remainder = 0;
+		for (auto it = remaining.rbegin(); it != remaining.rend(); it++)
+		{
+			uint64_t current = (remainder << 32) | *it;
+			*it = (uint32_t)(current / 1000000000);
+			remainder = current % 1000000000;
+		}
+		blocks.push_back((uint32_t)remainder);
+		while (!remaining.empty() && remaining.back() == 0)
+			remaining.pop_back();
+	}
+
+	string returnValue = to_string(blocks.back());
+	for (auto it = blocks.rbegin() + 1; it != blocks.rend(); it++)
+	{
+		auto block = to_string(*it);
+		returnValue += string(9 - block.length(), '0') + block;
+	}
+	return returnValue;
+}
@@ -0,0 +1,211 @@
+#include "../../header/tools/BitsetModelSink.hpp"
+#include "../../header/datamodel/Instance.hpp"
+
+#include <cstring>
+
+optional<BitsetModelSink::Compression> BitsetModelSink::tryParseCompression(char const* s)
+{
+	if (strcmp(s, "None") == 0)
+		return Compression::None;
+
+#ifdef HAVE_ZLIB
+	if (strcmp(s, "Zlib") == 0)
+		return Compression::Zlib;
+#endif
+
+#ifdef HAVE_ZSTD
+	if (strcmp(s, "Zstd") == 0)
+		return Compression::Zstd;
+#endif
+
+	return {};
+}
+
+BitsetModelSink::BitsetModelSink(char const* path, Instance& instance, Compression const& compression) : compression(compression)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+	bitsetSize = (numberOfArguments + 63) / 64 * 8;
+
+	file = fopen(path, "wb");
+	if (file == nullptr)
+		return;
+
+	//The header is never compressed, such that the names can be read without decompressing the models
+	static constexpr char magic[] = { 'S', 'E', 'T', 'A', 'F', 'B', 'I', 'T' };
+	buffer.insert(buffer.end(), magic, magic + sizeof(magic));
+	addInteger(1, 4);
+	addInteger((uint64_t)compression, 4);
+	addInteger(numberOfArguments, 8);
+	size_t namesSizePosition = buffer.size();
+	addInteger(0, 8);
+	for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
+	{
+		auto& name = begin->getName();
+		buffer.insert(buffer.end(), name.begin(), name.end());
+		buffer.push_back(0);
+	}
+	uint64_t namesSize = buffer.size() - namesSizePosition - 8;
+	for (size_t i = 0; i < 8; i++)
+		buffer[namesSizePosition + i] = (char)(namesSize >> (8 * i));
+
+	//The names are padded as a whole, their size excludes the padding
+	buffer.resize((buffer.size() + 7) / 8 * 8, 0);
+	fwrite(buffer.data(), 1, buffer.size(), file);
+	buffer.clear();
+
+#ifdef HAVE_ZLIB
+	if (compression == Compression::Zlib)
+		deflateInit(&zlibStream, Z_BEST_SPEED);
+#endif
+#ifdef HAVE_ZSTD
+	if (compression == Compression::Zstd)
+		zstdContext = ZSTD_createCCtx();
+#endif
+
+	buffer.reserve(bufferSize + bitsetSize);
+	pendingBuffer.reserve(bufferSize + bitsetSize);
+	compressedBuffer.resize(1 << 20);
+	writer = thread(&BitsetModelSink::writePendingBuffers, this);
+}
+
+BitsetModelSink::~BitsetModelSink()
+{
+	close();
+}
+
+bool BitsetModelSink::isOpen() const
+{
+	return file != nullptr;
+}
+
+void BitsetModelSink::addModel(unsigned long const&, vector<ID> const& inArguments)
+{
+	auto offset = buffer.size();
+	buffer.resize(offset + bitsetSize, 0);
+	auto bitset = buffer.data() + offset;
+	for (auto& id : inArguments)
+		bitset[id >> 3] |= (char)(1 << (id & 7));
+
+	if (buffer.size() >= bufferSize)
+		handOver();
+}
+
+void BitsetModelSink::flush()
+{
+	if (file != nullptr && !buffer.empty())
+		handOver();
+}
+
+void BitsetModelSink::close()
+{
+	if (file == nullptr)
+		return;
+
+	flush();
+
+	{
+		lock_guard<mutex> lock(bufferMutex);
+		isClosing = true;
+	}
+	bufferChanged.notify_all();
+	writer.join();
+
+#ifdef HAVE_ZLIB
+	if (compression == Compression::Zlib)
+		deflateEnd(&zlibStream);
+#endif
+#ifdef HAVE_ZSTD
+	if (compression == Compression::Zstd)
+		ZSTD_freeCCtx(zstdContext);
+#endif
+
+	fclose(file);
+	file = nullptr;
+}
+
+void BitsetModelSink::addInteger(uint64_t value, size_t const& bytes)
+{
+	for (size_t i = 0; i < bytes; i++)
+		buffer.push_back((char)(value >> (8 * i)));
+}
+
+void BitsetModelSink::handOver()
+{
+	unique_lock<mutex> lock(bufferMutex);
+	bufferChanged.wait(lock, [this] { return !hasPendingBuffer; });
+	buffer.swap(pendingBuffer);
+	hasPendingBuffer = true;
+	lock.unlock();
+	bufferChanged.notify_all();
+}
+
+void BitsetModelSink::writePendingBuffers()
+{
+	unique_lock<mutex> lock(bufferMutex);
+	while (true)
+	{
+		bufferChanged.wait(lock, [this] { return hasPendingBuffer || isClosing; });
+		if (!hasPendingBuffer)
+		{
+			//Every buffer has been written, only the end of the compressed stream remains
+			write(pendingBuffer, true);
+			return;
+		}
+
+		//The search thread only touches the pending buffer after it has been marked as written
+		lock.unlock();
+		write(pendingBuffer, false);
+		pendingBuffer.clear();
+		lock.lock();
+
+		hasPendingBuffer = false;
+		bufferChanged.notify_all();
+	}
+}
+
+void BitsetModelSink::write(vector<char> const& bytes, bool const& isLast)
+{
+	if (ferror(file))
+		return;
+
+	switch (compression)
+	{
+		case Compression::None:
+			fwrite(bytes.data(), 1, bytes.size(), file);
+			break;
+
+		case Compression::Zlib:
+		{
+#ifdef HAVE_ZLIB
+			zlibStream.next_in = (Bytef*)bytes.data();
+			zlibStream.avail_in = (uInt)bytes.size();
+			int result;
+			do
+			{
+				zlibStream.next_out = (Bytef*)compressedBuffer.data();
+				zlibStream.avail_out = (uInt)compressedBuffer.size();
+				result = deflate(&zlibStream, isLast ? Z_FINISH : Z_NO_FLUSH);
+				fwrite(compressedBuffer.data(), 1, compressedBuffer.size() - zlibStream.avail_out, file);
+			} while (zlibStream.avail_out == 0 || (isLast && result == Z_OK));
+#endif
+			break;
+		}
+
+		case Compression::Zstd:
+		{
+#ifdef HAVE_ZSTD
+			ZSTD_inBuffer input = { bytes.data(), bytes.size(), 0 };
+			size_t remaining;
+			do
+			{
+				ZSTD_outBuffer output = { compressedBuffer.data(), compressedBuffer.size(), 0 };
+				remaining = ZSTD_compressStream2(zstdContext, &output, &input, isLast ? ZSTD_e_end : ZSTD_e_continue);
+				if (ZSTD_isError(remaining))
+					return;
+				fwrite(compressedBuffer.data(), 1, output.pos, file);
+			} while (isLast ? remaining != 0 : input.pos != input.size);
+#endif
+			break;
+		}
+	}
+}
@@ -0,0 +1,160 @@
+#include "../../header/tools/Components.hpp"
+#include "../../header/tools/Helper.hpp"
+#include <limits>
+#include <cassert>
+
+using namespace std;
+
+vector<vector<ID>> Components::computeAttacks(Instance& instance)
+{
+	vector<vector<ID>> attacks(instance.getNumberOfArguments());
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto attackedArgumentId = memberBegin->first->getId();
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+			attacks[memberBegin->first->getId()].push_back(attackedArgumentId);
+	}
+	return attacks;
+}
+
+vector<ID> Components::computeStronglyConnected(Instance& instance, ID& numberOfComponents)
+{
+	return computeStronglyConnected(computeAttacks(instance), numberOfComponents);
+}
+
+vector<ID> Components::computeStronglyConnected(vector<vector<ID>> const& attacks, ID& numberOfComponents)
+{
+	const ID unvisited = numeric_limits<ID>::max();
+	auto numberOfArguments = (ID)attacks.size();
+
+	//Iterative version of Tarjan's algorithm, as the recursion depth would be the length of the longest path otherwise
+	vector<ID> component(numberOfArguments, unvisited);
+	vector<ID> index(numberOfArguments, unvisited);
+	vector<ID> lowLink(numberOfArguments, 0);
+	vector<bool> isOnStack(numberOfArguments, false);
+	vector<ID> stack;
+	vector<pair<ID, size_t>> callStack; //The argument and the index of the next attack to follow
+	ID nextIndex = 0;
+	numberOfComponents = 0;
+
+	for (ID root = 0; root < numberOfArguments; root++)
+	{
+		if (index[root] != unvisited)
+			continue;
+
+		Helper::throwExceptionIfReceivedSignal();
+
+		callStack.emplace_back(root, 0);
+		while (!callStack.empty())
+		{
+			auto& [argument, attackIndex] = callStack.back();
+			if (attackIndex == 0 && index[argument] == unvisited)
+			{
+				//First visit of the argument
+				index[argument] = lowLink[argument] = nextIndex++;
+				stack.push_back(argument);
+				isOnStack[argument] = true;
+			}
+
+			if (attackIndex < attacks[argument].size())
+			{
+				auto attacked = attacks[argument][attackIndex++];
+				if (index[attacked] == unvisited)
+					callStack.emplace_back(attacked, 0); //Invalidates argument and attackIndex
+				else if (isOnStack[attacked])
+					lowLink[argument] = min(lowLink[argument], index[attacked]);
+				continue;
+			}
+
+			//All attacks have been followed. If the argument is the root of a component, pop the component from the stack
+			auto finished = argument;
+			if (lowLink[finished] == index[finished])
+			{
+				ID member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					isOnStack[member] = false;
+					component[member] = numberOfComponents;
+				} while (member != finished);
+				numberOfComponents++;
+			}
+
+			callStack.pop_back();
+			if (!callStack.empty())
+			{
+				auto parent = callStack.back().first;
+				lowLink[parent] = min(lowLink[parent], lowLink[finished]);
+			}
+		}
+	}
+
+	//Tarjan's algorithm finds the components in reverse topological order
+	for (auto& id : component)
+	{
+		assert(id < numberOfComponents);
+		id = numberOfComponents - 1 - id;
+	}
+
+	return component;
+}
+
+ID Components::findRepresentative(vector<ID>& parents, ID argument)
+{
+	auto root = argument;
+	while (parents[root] != root)
+		root = parents[root];
+
+	while (parents[argument] != root)
+	{
+		auto next = parents[argument];
+		parents[argument] = root;
+		argument = next;
+	}
+
+	return root;
+}
+
+vector<ID> Components::computeWeaklyConnected(Instance& instance, ID& numberOfComponents)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	//Union all members of every attack
+	vector<ID> parents(numberOfArguments);
+	for (ID i = 0; i < numberOfArguments; i++)
+		parents[i] = i;
+
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		auto [memberBegin, memberEnd] = begin->getMembersIterator();
+		auto root = findRepresentative(parents, memberBegin->first->getId());
+		for (memberBegin++; memberBegin != memberEnd; memberBegin++)
+		{
+			auto otherRoot = findRepresentative(parents, memberBegin->first->getId());
+			if (otherRoot != root)
+			{
+				//Keep the lower id as root, such that the numbering below follows the lowest ids
+				if (otherRoot < root)
+					swap(root, otherRoot);
+				parents[otherRoot] = root;
+			}
+		}
+	}
+
+	//Number the components
+	const ID unnumbered = numeric_limits<ID>::max();
+	vector<ID> componentOfRoot(numberOfArguments, unnumbered);
+	vector<ID> component(numberOfArguments);
+	numberOfComponents = 0;
+	for (ID i = 0; i < numberOfArguments; i++)
+	{
+		auto root = findRepresentative(parents, i);
+		if (componentOfRoot[root] == unnumbered)
+			componentOfRoot[root] = numberOfComponents++;
+		component[i] = componentOfRoot[root];
+	}
+
+	return component;
+}
@@ -0,0 +1,189 @@
+#include "../../header/tools/ModelDecoder.hpp"
+#include "../../header/datamodel/Argument.hpp"
+#include "../../header/tools/Helper.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+#include <fmt/core.h>
+
+ModelDecoder::ModelDecoder(Instance& instance, ModelSink& modelSink) : instance(instance), modelSink(modelSink)
+{
+	for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
+	{
+		auto [entry, isInserted] = idOfName.try_emplace(string_view(begin->getName()), begin->getId());
+		if (!isInserted)
+			entry->second = nullopt;
+	}
+}
+
+ModelDecoder::~ModelDecoder()
+{
+	free(line);
+}
+
+bool ModelDecoder::decode(char const* path)
+{
+	file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+	if (file == nullptr)
+	{
+		error = fmt::format("Failed to open the model file {}", path);
+		return false;
+	}
+
+	bool isDecoded = true;
+	bool isKeyframeNext = false;
+	ssize_t length;
+	while (isDecoded && (length = readLine()) != -1)
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		char* begin = line;
+		char* end = line + length;
+		if (end != begin && end[-1] == '\n')
+			end--;
+
+		if (isKeyframeNext)
+		{
+			isKeyframeNext = false;
+			isDecoded = parseArguments(begin, end, false);
+			if (isDecoded)
+				modelSink.addModel(modelNumber, arguments);
+			continue;
+		}
+
+		//A keyframe gives the number of its model
+		unsigned long number = 0;
+		if (end - begin > 6 && strncmp(begin, "Model ", 6) == 0)
+		{
+			auto [numberEnd, result] = from_chars(begin + 6, end, number);
+			if (result == errc() && numberEnd == end && number != 0)
+			{
+				modelNumber = number;
+				isKeyframeNext = true;
+				continue;
+			}
+		}
+
+		if (modelNumber != 0 && begin != end && (*begin == '+' || *begin == '-'))
+		{
+			isDecoded = parseArguments(begin, end, true) && applyChanges();
+			if (isDecoded)
+				modelSink.addModel(++modelNumber, arguments);
+			continue;
+		}
+
+		//The models that have been decoded precede the copied line
+		modelSink.flush();
+		fwrite(line, 1, length, stdout);
+	}
+
+	if (isDecoded && isKeyframeNext)
+		isDecoded = reject("The arguments of the keyframe are missing");
+
+	if (file != stdin)
+		fclose(file);
+	file = nullptr;
+	modelSink.flush();
+	fflush(stdout);
+	return isDecoded;
+}
+
+string const& ModelDecoder::getError() const
+{
+	return error;
+}
+
+unsigned long ModelDecoder::getModelCount() const
+{
+	return modelNumber;
+}
+
+ssize_t ModelDecoder::readLine()
+{
+	auto length = getline(&line, &lineCapacity, file);
+	if (length != -1)
+		lineCount++;
+	return length;
+}
+
+bool ModelDecoder::parseArguments(char* begin, char* end, bool const& isDelta)
+{
+	if (isDelta)
+		changes.clear();
+	else
+		arguments.clear();
+
+	bool isFirst = true;
+	ID previousId = 0;
+	while (begin != end)
+	{
+		auto tokenEnd = (char*)memchr(begin, ' ', end - begin);
+		if (tokenEnd == nullptr)
+			tokenEnd = end;
+
+		bool isEntering = true;
+		auto nameBegin = begin;
+		if (isDelta)
+		{
+			if (*begin != '+' && *begin != '-')
+				return reject(fmt::format("The change {} is neither prefixed by + nor by -", string_view(begin, tokenEnd - begin)));
+			isEntering = *begin == '+';
+			nameBegin++;
+		}
+
+		string_view name(nameBegin, tokenEnd - nameBegin);
+		auto entry = idOfName.find(name);
+		if (entry == idOfName.end())
+			return reject(fmt::format("The argument {} is unknown", name));
+		if (!entry->second)
+			return reject(fmt::format("The name of the argument {} is not unique", name));
+
+		auto id = *entry->second;
+		if (!isFirst && id <= previousId)
+			return reject(fmt::format("The argument {} is not in ascending order", name));
+		previousId = id;
+		isFirst = false;
+
+		if (isDelta)
+			changes.emplace_back(id, isEntering);
+		else
+			arguments.push_back(id);
+
+		begin = tokenEnd == end ? end : tokenEnd + 1;
+	}
+
+	return true;
+}
+
+bool ModelDecoder::applyChanges()
+{
+	arguments.swap(previousArguments);
+	arguments.clear();
+
+	auto previous = previousArguments.begin();
+	for (auto& [id, isEntering] : changes)
+	{
+		while (previous != previousArguments.end() && *previous < id)
+			arguments.push_back(*previous++);
+
+		bool isIn = previous != previousArguments.end() && *previous == id;
+		if (isEntering && isIn)
+			return reject(fmt::format("The argument {} enters, but is already in", instance.getArgument(id).getName()));
+		if (!isEntering && !isIn)
+			return reject(fmt::format("The argument {} leaves, but is not in", instance.getArgument(id).getName()));
+
+		if (isIn)
+			previous++;
+		else
+			arguments.push_back(id);
+	}
+	arguments.insert(arguments.end(), previous, previousArguments.end());
+	return true;
+}
+
+bool ModelDecoder::reject(string const& reason)
+{
+	error = fmt::format("Line {}: {}", lineCount, reason);
+	return false;
+}
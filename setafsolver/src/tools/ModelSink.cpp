@@ -0,0 +1,154 @@
+#include "../../header/tools/ModelSink.hpp"
+#include "../../header/datamodel/Instance.hpp"
+
+#include <charconv>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+
+bool ModelSink::requiresModels() const
+{
+	return true;
+}
+
+void ModelSink::flush()
+{
+}
+
+TextModelSink::TextModelSink(Instance& instance)
+{
+	nameOffsets.reserve(instance.getNumberOfArguments() + 1);
+	for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
+	{
+		nameOffsets.push_back(names.size());
+		auto& name = begin->getName();
+		names.insert(names.end(), name.begin(), name.end());
+	}
+	nameOffsets.push_back(names.size());
+
+	buffer.reserve(bufferSize + 1024);
+}
+
+TextModelSink::~TextModelSink()
+{
+	flush();
+}
+
+void TextModelSink::addModel(unsigned long const& modelNumber, vector<ID> const& inArguments)
+{
+	static constexpr char header[] = { 'M', 'o', 'd', 'e', 'l', ' ' };
+	buffer.insert(buffer.end(), header, header + sizeof(header));
+	char digits[24];
+	auto digitsEnd = to_chars(digits, digits + sizeof(digits), modelNumber).ptr;
+	buffer.insert(buffer.end(), digits, digitsEnd);
+	buffer.push_back('\n');
+
+	bool isFirst = true;
+	for (auto& id : inArguments)
+	{
+		if (!isFirst)
+			buffer.push_back(' ');
+		appendName(id);
+		isFirst = false;
+	}
+	buffer.push_back('\n');
+
+	flushIfFull();
+}
+
+void TextModelSink::flush()
+{
+	if (buffer.empty())
+		return;
+
+	//The models follow the messages that have been printed through the streams before
+	cout.flush();
+	fflush(stdout);
+
+	size_t written = 0;
+	while (written < buffer.size())
+	{
+		auto result = write(STDOUT_FILENO, buffer.data() + written, buffer.size() - written);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			break; //The output has been closed, thus the models are dropped
+		written += result;
+	}
+	buffer.clear();
+}
+
+void TextModelSink::appendName(ID const& id)
+{
+	buffer.insert(buffer.end(), names.data() + nameOffsets[id], names.data() + nameOffsets[id + 1]);
+}
+
+void TextModelSink::flushIfFull()
+{
+	if (buffer.size() >= bufferSize)
+		flush();
+}
+
+DeltaModelSink::DeltaModelSink(Instance& instance, unsigned long const& keyframeInterval) : TextModelSink(instance), keyframeInterval(keyframeInterval)
+{
+}
+
+void DeltaModelSink::addModel(unsigned long const& modelNumber, vector<ID> const& inArguments)
+{
+	//The decoder numbers the changes by counting from the last keyframe, thus a gap in the numbers needs a keyframe as well
+	if ((modelNumber - 1) % keyframeInterval == 0 || modelNumber != previousModelNumber + 1)
+		TextModelSink::addModel(modelNumber, inArguments);
+	else
+	{
+		//Merge the ascending arguments of both models
+		bool isFirst = true;
+		auto previous = previousArguments.cbegin(), current = inArguments.cbegin();
+		while (previous != previousArguments.end() || current != inArguments.end())
+		{
+			if (current != inArguments.end() && previous != previousArguments.end() && *current == *previous)
+			{
+				previous++;
+				current++;
+				continue;
+			}
+
+			if (!isFirst)
+				buffer.push_back(' ');
+			isFirst = false;
+			if (previous == previousArguments.end() || (current != inArguments.end() && *current < *previous))
+			{
+				buffer.push_back('+');
+				appendName(*current++);
+			}
+			else
+			{
+				buffer.push_back('-');
+				appendName(*previous++);
+			}
+		}
+		buffer.push_back('\n');
+		flushIfFull();
+	}
+
+	previousModelNumber = modelNumber;
+	previousArguments.assign(inArguments.begin(), inArguments.end());
+}
+
+bool CountingModelSink::requiresModels() const
+{
+	return false;
+}
+
+void CountingModelSink::addModel(unsigned long const&, vector<ID> const&)
+{
+}
+
+CallbackModelSink::CallbackModelSink(function<void(unsigned long const&, vector<ID> const&)> callback) : callback(std::move(callback))
+{
+}
+
+void CallbackModelSink::addModel(unsigned long const& modelNumber, vector<ID> const& inArguments)
+{
+	callback(modelNumber, inArguments);
+}
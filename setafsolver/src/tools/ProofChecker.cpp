@@ -0,0 +1,837 @@
+#include "../../header/tools/ProofChecker.hpp"
+#include "../../header/datamodel/Argument.hpp"
+#include "../../header/datamodel/Clause.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fmt/core.h>
+
+ProofChecker::ProofChecker(Instance& instance, ProofWriter::Format const& format, bool const& isHinted, bool const& isRecording) : instance(instance), format(format),
+	isHinted(isHinted), isRecording(isRecording)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+	values.assign(numberOfArguments, 0);
+	reasons.assign(numberOfArguments, 0);
+	isMarked.assign(numberOfArguments, false);
+	watches.resize(2 * numberOfArguments);
+
+	//The attacks are the input clauses, the subsumed ones have been removed by the parser and keep their numbers unused
+	lastClauseId = instance.getNumberOfInputAttacks();
+	clauses.reserve(instance.getNumberOfAttacks());
+	indexOfClause.reserve(instance.getNumberOfAttacks());
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		lineLiterals.clear();
+		for (auto [memberBegin, memberEnd] = begin->getMembersIterator(); memberBegin != memberEnd; memberBegin++)
+			lineLiterals.push_back(2 * memberBegin->first->getId() + (memberBegin->second == -1 ? 1 : 0));
+		addClause(begin->getProofId(), lineLiterals);
+	}
+
+	for (auto [begin, end] = instance.getRequiredArgumentsIterator(); begin != end; begin++)
+		requiredLiterals.push_back(2 * begin->first->getId() + (begin->second == -1 ? 1 : 0));
+
+	if (format == ProofWriter::Format::Text)
+		for (auto [begin, end] = instance.getArgumentsIterator(); begin != end; begin++)
+		{
+			auto [entry, isInserted] = literalOfName.try_emplace(begin->getName(), 2 * begin->getId());
+			if (!isInserted)
+				entry->second.reset();
+		}
+}
+
+bool ProofChecker::check(char const* path)
+{
+	file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+	if (file == nullptr)
+	{
+		error = fmt::format("Failed to open the proof file {}", path);
+		return false;
+	}
+
+	readBuffer.reserve(readBufferSize);
+	bool isVerified = checkLines();
+	if (file != stdin)
+		fclose(file);
+	file = nullptr;
+	return isVerified;
+}
+
+string const& ProofChecker::getError() const
+{
+	return error;
+}
+
+unsigned long ProofChecker::getHintedLemmaCount() const
+{
+	return hintedLemmaCount;
+}
+
+unsigned long ProofChecker::getPropagatedLemmaCount() const
+{
+	return propagatedLemmaCount;
+}
+
+unsigned long ProofChecker::getImplicitClauseCount() const
+{
+	return implicitClauseCount;
+}
+
+unsigned long ProofChecker::getDeletedClauseCount() const
+{
+	return deletedClauseCount;
+}
+
+size_t ProofChecker::getPeakClauseMemory() const
+{
+	return peakClauseMemory;
+}
+
+bool ProofChecker::checkLines()
+{
+	while (readLine())
+	{
+		if (lineKind == ProofWriter::LineKind::Deletion)
+		{
+			if (!isHinted)
+			{
+				if (!deleteClauseWithLiterals())
+					return false;
+				continue;
+			}
+
+			for (auto& id : lineLiterals)
+				if (!deleteClause(id))
+					return false;
+			continue;
+		}
+
+		//The numbers of the added clauses are increasing, without hints they are implicit
+		if (!isHinted)
+			lineId = lastClauseId + 1;
+		if (lineId <= lastClauseId)
+			return reject(fmt::format("The clause number {} has already been used, a proof written without -l is checked with -u", lineId));
+		lastClauseId = lineId;
+
+		if (lineKind == ProofWriter::LineKind::Implicit)
+		{
+			if (!checkImplicitClause())
+				return reject("The implicit clause does not contain its argument and a supporting argument of every attack on it");
+			lineDependencies.clear();
+			implicitClauseCount++;
+		}
+		else if (lineHints.empty())
+		{
+			if (!checkByPropagation())
+				return reject("The clause does not follow by unit propagation");
+			propagatedLemmaCount++;
+		}
+		else
+		{
+			if (!checkHints())
+				return false;
+			hintedLemmaCount++;
+		}
+
+		if (isRecording)
+			recordLine();
+		if (lineLiterals.empty())
+			return true;
+		addClause(lineId, lineLiterals);
+	}
+
+	if (error.empty())
+		error = "The proof ends without deriving the empty clause";
+	return false;
+}
+
+bool ProofChecker::readLine()
+{
+	lineId = 0;
+	lineLiterals.clear();
+	lineHints.clear();
+	return format == ProofWriter::Format::Text ? readTextLine() : readBinaryLine();
+}
+
+bool ProofChecker::readTextLine()
+{
+	if (!readTextTokens())
+		return false;
+
+	size_t position = 0;
+	ID number;
+	Literal literal;
+	if (lineTokens[0] == "d")
+	{
+		//Without hints, the deleted clause is given by its literals
+		lineKind = ProofWriter::LineKind::Deletion;
+		for (position = 1; position < lineTokenCount && lineTokens[position] != "0"; position++)
+		{
+			if (!isHinted)
+			{
+				if (!parseLiteral(lineTokens[position], literal))
+					return reject(fmt::format("The argument {} is unknown or its name is not unique", lineTokens[position]));
+				lineLiterals.push_back(literal);
+			}
+			else if (!parseNumber(lineTokens[position], number))
+				return reject(fmt::format("The clause number {} is malformed", lineTokens[position]));
+			else
+				lineLiterals.push_back(number);
+		}
+	}
+	else
+	{
+		if (isHinted && !parseNumber(lineTokens[0], lineId))
+			return reject("The line does not start with a clause number, a proof written without -l is checked with -u");
+
+		position = isHinted ? 1 : 0;
+		lineKind = ProofWriter::LineKind::Lemma;
+		if (position < lineTokenCount && lineTokens[position] == "i")
+		{
+			lineKind = ProofWriter::LineKind::Implicit;
+			position++;
+		}
+
+		for (; position < lineTokenCount && lineTokens[position] != "0"; position++)
+		{
+			if (!parseLiteral(lineTokens[position], literal))
+				return reject(fmt::format("The argument {} is unknown or its name is not unique", lineTokens[position]));
+			lineLiterals.push_back(literal);
+		}
+
+		//A derived clause is followed by its hints, which are terminated by 0 too
+		if (isHinted && lineKind == ProofWriter::LineKind::Lemma && position < lineTokenCount)
+			for (position++; position < lineTokenCount && lineTokens[position] != "0"; position++)
+			{
+				if (!parseNumber(lineTokens[position], number))
+					return reject(fmt::format("The hint {} is malformed", lineTokens[position]));
+				lineHints.push_back(number);
+			}
+	}
+
+	if (position + 1 != lineTokenCount)
+		return reject("The line is not terminated by 0");
+	return true;
+}
+
+bool ProofChecker::readTextTokens()
+{
+	auto isBlank = [](int byte) { return byte == ' ' || byte == '\t' || byte == '\r'; };
+
+	int byte = readByte();
+	while (byte == '\n' || isBlank(byte))
+		byte = readByte();
+	if (byte == -1)
+		return false;
+
+	lineCount++;
+	lineTokenCount = 0;
+	while (byte != -1 && byte != '\n')
+	{
+		if (isBlank(byte))
+		{
+			byte = readByte();
+			continue;
+		}
+
+		if (lineTokenCount == lineTokens.size())
+			lineTokens.emplace_back();
+		auto& token = lineTokens[lineTokenCount++];
+		token.clear();
+		for (; byte != -1 && byte != '\n' && !isBlank(byte); byte = readByte())
+			token.push_back((char)byte);
+	}
+
+	return true;
+}
+
+bool ProofChecker::parseNumber(string const& token, ID& number) const
+{
+	auto [end, errorCode] = from_chars(token.data(), token.data() + token.size(), number);
+	return errorCode == errc() && end == token.data() + token.size() && number != 0;
+}
+
+bool ProofChecker::parseLiteral(string& token, Literal& literal) const
+{
+	bool isNegated = token[0] == '-';
+	if (isNegated)
+		token.erase(0, 1);
+
+	auto entry = literalOfName.find(token);
+	if (entry == literalOfName.end() || !entry->second.has_value())
+		return false;
+
+	literal = *entry->second + (isNegated ? 1 : 0);
+	return true;
+}
+
+bool ProofChecker::readBinaryLine()
+{
+	int kind = readByte();
+	if (kind == -1)
+		return false;
+
+	lineCount++;
+	if (kind == 'a')
+		lineKind = ProofWriter::LineKind::Lemma;
+	else if (kind == 'i')
+		lineKind = ProofWriter::LineKind::Implicit;
+	else if (kind == 'd')
+		lineKind = ProofWriter::LineKind::Deletion;
+	else
+		return reject(fmt::format("The line starts with the unknown kind {}", kind));
+
+	ID value;
+	if (lineKind == ProofWriter::LineKind::Deletion && isHinted)
+	{
+		while (true)
+		{
+			if (!readVariableLengthInteger(value))
+				return reject("The file ends within the line");
+			if (value == 0)
+				return true;
+			lineLiterals.push_back(value);
+		}
+	}
+
+	//Without hints, the lines are not numbered and the deleted clause is given by its literals
+	if (lineKind != ProofWriter::LineKind::Deletion && isHinted && (!readVariableLengthInteger(lineId) || lineId == 0))
+		return reject("The line does not start with a clause number, a proof written without -l is checked with -u");
+
+	//A literal is twice the number of the argument in the instance file, plus 1 if it is negated
+	while (true)
+	{
+		if (!readVariableLengthInteger(value))
+			return reject("The file ends within the line");
+		if (value == 0)
+			break;
+		if (value / 2 == 0 || value / 2 > instance.getNumberOfArguments())
+			return reject(fmt::format("The argument {} does not exist", value / 2));
+		lineLiterals.push_back(value - 2);
+	}
+
+	if (isHinted && lineKind == ProofWriter::LineKind::Lemma)
+		while (true)
+		{
+			if (!readVariableLengthInteger(value))
+				return reject("The file ends within the line");
+			if (value == 0)
+				break;
+			lineHints.push_back(value);
+		}
+
+	return true;
+}
+
+int ProofChecker::readByte()
+{
+	if (readPosition == readBuffer.size())
+	{
+		readBuffer.resize(readBufferSize);
+		readBuffer.resize(fread(readBuffer.data(), 1, readBufferSize, file));
+		readPosition = 0;
+		if (readBuffer.empty())
+			return -1;
+	}
+
+	return (unsigned char)readBuffer[readPosition++];
+}
+
+bool ProofChecker::readVariableLengthInteger(ID& value)
+{
+	value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		int byte = readByte();
+		if (byte == -1)
+			return false;
+
+		value |= (ID)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+bool ProofChecker::reject(string const& reason)
+{
+	error = fmt::format("Line {}: {}", lineCount, reason);
+	return false;
+}
+
+void ProofChecker::addClause(ID const& id, vector<Literal> const& clauseLiterals)
+{
+	auto index = clauses.size();
+	auto& clause = clauses.emplace_back();
+	clause.offset = literals.size();
+	clause.size = clauseLiterals.size();
+	clause.id = id;
+	clause.isActive = true;
+	literals.insert(literals.end(), clauseLiterals.begin(), clauseLiterals.end());
+	indexOfClause[id] = index;
+	if (!isHinted)
+		clausesOfHash[hashLiterals(clauseLiterals.data(), clauseLiterals.data() + clauseLiterals.size())].push_back(id);
+
+	if (clause.size == 1)
+		unitClauses.push_back(index);
+	else if (clause.size > 1)
+	{
+		watches[clauseLiterals[0]].push_back(index);
+		watches[clauseLiterals[1]].push_back(index);
+	}
+
+	peakClauseMemory = max(peakClauseMemory, literals.size() * sizeof(Literal) + clauses.size() * sizeof(StoredClause));
+}
+
+bool ProofChecker::deleteClause(ID const& id)
+{
+	auto entry = indexOfClause.find(id);
+	if (entry == indexOfClause.end())
+		return reject(fmt::format("The deleted clause {} does not exist", id));
+
+	auto& clause = clauses[entry->second];
+	clause.isActive = false;
+	deletedLiteralCount += clause.size;
+	indexOfClause.erase(entry);
+	deletedClauseCount++;
+
+	if (deletedLiteralCount > literals.size() / 2)
+		compact();
+	return true;
+}
+
+bool ProofChecker::deleteClauseWithLiterals()
+{
+	auto entry = clausesOfHash.find(hashLiterals(lineLiterals.data(), lineLiterals.data() + lineLiterals.size()));
+	if (entry != clausesOfHash.end())
+	{
+		//The literals of a stored clause are reordered by the watches, thus both are compared sorted. The last added of equal clauses is deleted
+		sort(lineLiterals.begin(), lineLiterals.end());
+		auto& ids = entry->second;
+		for (auto i = ids.size(); i-- > 0; )
+		{
+			auto& clause = clauses[indexOfClause.find(ids[i])->second];
+			sortedLiterals.assign(literals.begin() + clause.offset, literals.begin() + clause.offset + clause.size);
+			sort(sortedLiterals.begin(), sortedLiterals.end());
+			if (sortedLiterals != lineLiterals)
+				continue;
+
+			auto id = ids[i];
+			ids.erase(ids.begin() + i);
+			if (ids.empty())
+				clausesOfHash.erase(entry);
+			return deleteClause(id);
+		}
+	}
+
+	return reject("The deleted clause does not exist");
+}
+
+uint64_t ProofChecker::hashLiterals(Literal const* begin, Literal const* end)
+{
+	//The mixed literals are summed, such that the order does not matter
+	uint64_t hash = end - begin;
+	for (; begin != end; begin++)
+	{
+		uint64_t mixed = (uint64_t)*begin * 0x9e3779b97f4a7c15ULL;
+		hash += mixed ^ (mixed >> 29);
+	}
+	return hash;
+}
+
+void ProofChecker::compact()
+{
+	//The clauses and their literals keep their order, thus they are moved towards the front only
+	size_t keptClauses = 0, keptLiterals = 0;
+	for (auto& clause : clauses)
+	{
+		if (!clause.isActive)
+			continue;
+
+		copy(literals.begin() + clause.offset, literals.begin() + clause.offset + clause.size, literals.begin() + keptLiterals);
+		clause.offset = keptLiterals;
+		keptLiterals += clause.size;
+		clauses[keptClauses++] = clause;
+	}
+	clauses.resize(keptClauses);
+	literals.resize(keptLiterals);
+	deletedLiteralCount = 0;
+
+	//No literal is assigned between the lines, thus the watched literals are the first two of every clause
+	for (auto& watching : watches)
+		watching.clear();
+	unitClauses.clear();
+	for (size_t index = 0; index < clauses.size(); index++)
+	{
+		auto& clause = clauses[index];
+		indexOfClause[clause.id] = index;
+		if (clause.size == 1)
+			unitClauses.push_back(index);
+		else if (clause.size > 1)
+		{
+			watches[literals[clause.offset]].push_back(index);
+			watches[literals[clause.offset + 1]].push_back(index);
+		}
+	}
+}
+
+bool ProofChecker::checkImplicitClause()
+{
+	if (lineLiterals.empty() || (lineLiterals[0] & 1) != 0)
+		return false;
+
+	for (auto& literal : lineLiterals)
+		if ((literal & 1) == 0)
+			isMarked[literal / 2] = true;
+
+	//Every attack on the argument has to be blocked by an argument of its support that is out if the argument is out
+	bool isCorrect = true;
+	auto& argument = instance.getArgument(lineLiterals[0] / 2);
+	for (auto [begin, end] = argument.getAttackedByIterator(); begin != end && isCorrect; begin++)
+	{
+		if ((*begin)->isSelfAttack())
+			continue;
+
+		auto [memberBegin, memberEnd] = (*begin)->getMembersIterator();
+		isCorrect = any_of(memberBegin + 1, memberEnd, [this](pair<Argument*, Sign> const& member) { return isMarked[member.first->getId()]; });
+	}
+
+	for (auto& literal : lineLiterals)
+		isMarked[literal / 2] = false;
+	return isCorrect;
+}
+
+bool ProofChecker::checkHints()
+{
+	lineDependencies.clear();
+	isLineChain = false;
+	if (assignNegation())
+	{
+		undo();
+		return true;
+	}
+
+	//Every hinted clause has to be unit, the last one falsified. Hints after the falsified one are not needed
+	for (auto& hint : lineHints)
+	{
+		auto entry = indexOfClause.find(hint);
+		if (entry == indexOfClause.end())
+		{
+			undo();
+			return reject(fmt::format("The hint {} is not a clause of the proof", hint));
+		}
+
+		auto& clause = clauses[entry->second];
+		Literal unassigned = 0;
+		ID unassignedCount = 0;
+		for (ID i = 0; i < clause.size && unassignedCount < 2; i++)
+		{
+			auto literal = literals[clause.offset + i];
+			auto value = valueOf(literal);
+			if (value == 1)
+				unassignedCount = 2;
+			else if (value == 0)
+			{
+				unassigned = literal;
+				unassignedCount++;
+			}
+		}
+
+		if (unassignedCount == 0)
+		{
+			if (isRecording)
+			{
+				lineDependencies.assign(lineHints.begin(), lineHints.begin() + (&hint - lineHints.data()) + 1);
+				isLineChain = true;
+			}
+			undo();
+			return true;
+		}
+
+		if (unassignedCount > 1)
+		{
+			undo();
+			return reject(fmt::format("The hint {} is neither unit nor falsified", hint));
+		}
+
+		assign(unassigned, hint);
+	}
+
+	undo();
+	return reject("The hints do not falsify a clause");
+}
+
+bool ProofChecker::checkByPropagation()
+{
+	lineDependencies.clear();
+	isLineChain = false;
+	if (assignNegation())
+	{
+		undo();
+		return true;
+	}
+
+	auto negationSize = trail.size();
+	bool hasConflict = false;
+	conflictClauseId = 0;
+	for (auto& literal : requiredLiterals)
+	{
+		if (valueOf(literal) == -1)
+			hasConflict = true;
+		else if (valueOf(literal) == 0)
+			assign(literal, 0);
+	}
+
+	//The deleted unit clauses are removed on the way
+	size_t kept = 0;
+	for (auto& index : unitClauses)
+	{
+		if (!clauses[index].isActive)
+			continue;
+
+		unitClauses[kept++] = index;
+		auto literal = literals[clauses[index].offset];
+		if (valueOf(literal) == -1 && !hasConflict)
+		{
+			hasConflict = true;
+			conflictClauseId = clauses[index].id;
+		}
+		else if (valueOf(literal) == 0)
+			assign(literal, clauses[index].id);
+	}
+	unitClauses.resize(kept);
+
+	if (!hasConflict)
+		hasConflict = propagate(0);
+	if (hasConflict && isRecording)
+		collectDependencies(negationSize);
+	undo();
+	return hasConflict;
+}
+
+bool ProofChecker::assignNegation()
+{
+	for (auto& literal : lineLiterals)
+	{
+		auto value = valueOf(literal);
+		if (value == 1)
+			return true;
+		if (value == 0)
+			assign(literal ^ 1, 0);
+	}
+	return false;
+}
+
+bool ProofChecker::propagate(size_t position)
+{
+	for (; position < trail.size(); position++)
+	{
+		auto falseLiteral = trail[position] ^ 1;
+		auto& watching = watches[falseLiteral];
+		size_t kept = 0;
+		for (size_t i = 0; i < watching.size(); i++)
+		{
+			auto index = watching[i];
+			auto& clause = clauses[index];
+			if (!clause.isActive)
+				continue; //Deleted clauses are dropped from the watches
+
+			//The watched literals are the first two of the clause, the false one is moved to the second position
+			auto clauseLiterals = &literals[clause.offset];
+			if (clauseLiterals[0] == falseLiteral)
+				swap(clauseLiterals[0], clauseLiterals[1]);
+			if (valueOf(clauseLiterals[0]) == 1)
+			{
+				watching[kept++] = index;
+				continue;
+			}
+
+			bool isMoved = false;
+			for (ID j = 2; j < clause.size && !isMoved; j++)
+				if (valueOf(clauseLiterals[j]) != -1)
+				{
+					swap(clauseLiterals[1], clauseLiterals[j]);
+					watches[clauseLiterals[1]].push_back(index);
+					isMoved = true;
+				}
+			if (isMoved)
+				continue;
+
+			watching[kept++] = index;
+			if (valueOf(clauseLiterals[0]) == -1)
+			{
+				for (i++; i < watching.size(); i++)
+					watching[kept++] = watching[i];
+				watching.resize(kept);
+				conflictClauseId = clause.id;
+				return true;
+			}
+			assign(clauseLiterals[0], clause.id);
+		}
+		watching.resize(kept);
+	}
+
+	return false;
+}
+
+void ProofChecker::undo()
+{
+	for (auto& literal : trail)
+		values[literal / 2] = 0;
+	trail.clear();
+}
+
+Sign ProofChecker::valueOf(Literal const& literal) const
+{
+	auto value = values[literal / 2];
+	return (literal & 1) != 0 ? -value : value;
+}
+
+void ProofChecker::assign(Literal const& literal, ID const& reason)
+{
+	values[literal / 2] = (literal & 1) != 0 ? -1 : 1;
+	reasons[literal / 2] = reason;
+	trail.push_back(literal);
+}
+
+void ProofChecker::collectDependencies(size_t const& negationSize)
+{
+	//A falsified required argument follows from the negation alone, but the required arguments are no clauses that can be hinted
+	if (conflictClauseId == 0)
+		return;
+
+	auto markLiterals = [this](ID const& id)
+	{
+		auto& clause = clauses[indexOfClause.find(id)->second];
+		for (ID i = 0; i < clause.size; i++)
+			isMarked[literals[clause.offset + i] / 2] = true;
+	};
+
+	//The reasons of the marked assignments are needed, the negation of the line and the required arguments need no clause
+	isLineChain = true;
+	markLiterals(conflictClauseId);
+	for (auto i = trail.size(); i-- > negationSize; )
+	{
+		auto argument = trail[i] / 2;
+		if (!isMarked[argument])
+			continue;
+
+		if (reasons[argument] == 0)
+		{
+			isMarked[argument] = false;
+			isLineChain = false;
+			continue;
+		}
+
+		lineDependencies.push_back(reasons[argument]);
+		markLiterals(reasons[argument]);
+		isMarked[argument] = false;
+	}
+
+	for (size_t i = 0; i < negationSize; i++)
+		isMarked[trail[i] / 2] = false;
+	reverse(lineDependencies.begin(), lineDependencies.end());
+	lineDependencies.push_back(conflictClauseId);
+}
+
+void ProofChecker::recordLine()
+{
+	auto& line = recordedLines.emplace_back();
+	line.id = lineId;
+	line.kind = lineKind;
+	line.literalOffset = recordedLiterals.size();
+	line.literalCount = lineLiterals.size();
+	line.dependencyOffset = recordedDependencies.size();
+	line.dependencyCount = lineDependencies.size();
+	line.isChain = isLineChain;
+	recordedLiterals.insert(recordedLiterals.end(), lineLiterals.begin(), lineLiterals.end());
+	recordedDependencies.insert(recordedDependencies.end(), lineDependencies.begin(), lineDependencies.end());
+}
+
+unsigned long ProofChecker::writeTrimmedProof(ProofWriter& writer) const
+{
+	auto numberOfInputClauses = instance.getNumberOfInputAttacks();
+	auto indexOfLine = [this](ID const& id)
+	{
+		return (size_t)(lower_bound(recordedLines.begin(), recordedLines.end(), id, [](RecordedLine const& line, ID const& lineId) { return line.id < lineId; }) - recordedLines.begin());
+	};
+
+	//Backwards from the empty clause, the dependencies of needed lines are needed. The first use found is the last one, after which the clause is deleted
+	vector<bool> isNeeded(recordedLines.size(), false);
+	vector<bool> isAttackUsed(numberOfInputClauses + 1, false);
+	vector<vector<ID>> deletedAfter(recordedLines.size());
+	isNeeded.back() = true;
+	for (auto i = recordedLines.size(); i-- > 0; )
+	{
+		if (!isNeeded[i])
+			continue;
+
+		auto& line = recordedLines[i];
+		for (ID j = 0; j < line.dependencyCount; j++)
+		{
+			auto dependency = recordedDependencies[line.dependencyOffset + j];
+			bool isLastUse;
+			if (dependency <= numberOfInputClauses)
+			{
+				isLastUse = !isAttackUsed[dependency];
+				isAttackUsed[dependency] = true;
+			}
+			else
+			{
+				auto index = indexOfLine(dependency);
+				isLastUse = !isNeeded[index];
+				isNeeded[index] = true;
+			}
+
+			if (isLastUse && i + 1 != recordedLines.size())
+				deletedAfter[i].push_back(dependency);
+		}
+	}
+
+	//The added clauses are renumbered consecutively after the attacks, thus the hints and deletions are translated
+	vector<ID> newIds(recordedLines.size(), 0);
+	auto translate = [&](ID const& id) { return id <= numberOfInputClauses ? id : newIds[indexOfLine(id)]; };
+	vector<pair<Argument*, Sign>> clauseLiterals;
+	vector<ID> numbers;
+	unsigned long lemmaCount = 0;
+	for (size_t i = 0; i < recordedLines.size(); i++)
+	{
+		if (!isNeeded[i])
+			continue;
+
+		auto& line = recordedLines[i];
+		clauseLiterals.clear();
+		for (ID j = 0; j < line.literalCount; j++)
+		{
+			auto literal = recordedLiterals[line.literalOffset + j];
+			clauseLiterals.emplace_back(&instance.getArgument(literal / 2), (literal & 1) != 0 ? -1 : 1);
+		}
+
+		if (line.kind == ProofWriter::LineKind::Implicit)
+			newIds[i] = writer.writeClause(ProofWriter::LineKind::Implicit, clauseLiterals);
+		else if (clauseLiterals.empty())
+		{
+			writer.writeEmptyClause();
+			lemmaCount++;
+		}
+		else
+		{
+			numbers.clear();
+			if (line.isChain)
+				for (ID j = 0; j < line.dependencyCount; j++)
+					numbers.push_back(translate(recordedDependencies[line.dependencyOffset + j]));
+			newIds[i] = writer.writeLemma(clauseLiterals, numbers);
+			lemmaCount++;
+		}
+
+		if (deletedAfter[i].empty())
+			continue;
+
+		numbers.clear();
+		for (auto& id : deletedAfter[i])
+			numbers.push_back(translate(id));
+		writer.writeDeletion(numbers);
+	}
+
+	return lemmaCount;
+}
@@ -0,0 +1,259 @@
+#include "../../header/tools/ProofWriter.hpp"
+#include "../../header/datamodel/Argument.hpp"
+#include "../../header/datamodel/Clause.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+ProofWriter::ProofWriter(char const* path, Format const& format, bool const& isHinted) : format(format), isHinted(isHinted)
+{
+	if (strcmp(path, "-") == 0)
+	{
+		cout.flush();
+		fflush(stdout);
+		int descriptor = dup(STDOUT_FILENO);
+		if (descriptor != -1 && dup2(STDERR_FILENO, STDOUT_FILENO) != -1)
+			file = fdopen(descriptor, "wb");
+	}
+	else
+		file = fopen(path, "wb");
+
+	if (file == nullptr)
+		return;
+
+	buffer.reserve(bufferSize + 1024);
+	pendingBuffer.reserve(bufferSize + 1024);
+	writer = thread(&ProofWriter::writePendingBuffers, this);
+}
+
+ProofWriter::~ProofWriter()
+{
+	close();
+}
+
+bool ProofWriter::isOpen() const
+{
+	return file != nullptr;
+}
+
+bool ProofWriter::hasHints() const
+{
+	return isHinted;
+}
+
+void ProofWriter::setNumberOfInputClauses(ID const& numberOfInputClauses)
+{
+	nextClauseId = numberOfInputClauses + 1;
+}
+
+ID ProofWriter::writeClause(LineKind const& kind, Clause& clause)
+{
+	//With hints, a deleted clause is given by its number
+	if (kind == LineKind::Deletion && isHinted)
+	{
+		beginLine(kind);
+		addNumber(clause.getProofId());
+		endLine(kind, nullptr);
+		return 0;
+	}
+
+	auto id = beginLine(kind);
+	for (auto [beginMember, endMember] = clause.getMembersIterator(); beginMember != endMember; beginMember++)
+		addLiteral(*beginMember->first, beginMember->second);
+	endLine(kind, nullptr);
+
+	if (kind != LineKind::Deletion)
+		clause.setProofId(id);
+	return id;
+}
+
+ID ProofWriter::writeClause(LineKind const& kind, vector<pair<Argument*, Sign>> const& literals)
+{
+	auto id = beginLine(kind);
+	for (auto& [argument, sign] : literals)
+		addLiteral(*argument, sign);
+	endLine(kind, nullptr);
+	return id;
+}
+
+ID ProofWriter::writeLemma(Clause& clause, vector<ID> const& hints)
+{
+	auto id = beginLine(LineKind::Lemma);
+	for (auto [beginMember, endMember] = clause.getMembersIterator(); beginMember != endMember; beginMember++)
+		addLiteral(*beginMember->first, beginMember->second);
+	endLine(LineKind::Lemma, &hints);
+
+	clause.setProofId(id);
+	return id;
+}
+
+ID ProofWriter::writeLemma(vector<pair<Argument*, Sign>> const& literals, vector<ID> const& hints)
+{
+	auto id = beginLine(LineKind::Lemma);
+	for (auto& [argument, sign] : literals)
+		addLiteral(*argument, sign);
+	endLine(LineKind::Lemma, &hints);
+	return id;
+}
+
+void ProofWriter::writeDeletion(vector<ID> const& ids)
+{
+	beginLine(LineKind::Deletion);
+	for (auto& id : ids)
+		addNumber(id);
+	endLine(LineKind::Deletion, nullptr);
+}
+
+void ProofWriter::writeEmptyClause()
+{
+	//The text proof ends with the empty clause without a line break. It is always checked by unit propagation, thus its hints are empty
+	beginLine(LineKind::Lemma);
+	if (format == Format::Text)
+	{
+		buffer.push_back('0');
+		if (isHinted)
+			buffer.insert(buffer.end(), { ' ', '0' });
+	}
+	else
+	{
+		buffer.push_back(0);
+		if (isHinted)
+			buffer.push_back(0);
+	}
+}
+
+void ProofWriter::close()
+{
+	if (file == nullptr)
+		return;
+
+	if (!buffer.empty())
+		handOver();
+
+	{
+		lock_guard<mutex> lock(bufferMutex);
+		isClosing = true;
+	}
+	bufferChanged.notify_all();
+	writer.join();
+
+	fclose(file);
+	file = nullptr;
+}
+
+ID ProofWriter::beginLine(LineKind const& kind)
+{
+	ID id = kind == LineKind::Deletion ? 0 : nextClauseId++;
+	if (format == Format::Text)
+	{
+		//The number precedes the kind, such that every added clause starts with its number
+		if (isHinted && id != 0)
+			addNumber(id);
+		if (kind == LineKind::Implicit)
+			buffer.insert(buffer.end(), { 'i', ' ' });
+		else if (kind == LineKind::Deletion)
+			buffer.insert(buffer.end(), { 'd', ' ' });
+	}
+	else
+	{
+		buffer.push_back(kind == LineKind::Implicit ? 'i' : kind == LineKind::Deletion ? 'd' : 'a');
+		if (isHinted && id != 0)
+			addNumber(id);
+	}
+	return id;
+}
+
+void ProofWriter::addLiteral(Argument const& argument, Sign const& sign)
+{
+	if (format == Format::Text)
+	{
+		if (sign == -1)
+			buffer.push_back('-');
+		auto& name = argument.getName();
+		buffer.insert(buffer.end(), name.begin(), name.end());
+		buffer.push_back(' ');
+	}
+	else
+		addVariableLengthInteger(2 * (uint64_t)argument.getNumber() + (sign == -1 ? 1 : 0));
+}
+
+void ProofWriter::addNumber(ID const& number)
+{
+	if (format == Format::Text)
+	{
+		char digits[24];
+		auto end = to_chars(digits, digits + sizeof(digits), number).ptr;
+		buffer.insert(buffer.end(), digits, end);
+		buffer.push_back(' ');
+	}
+	else
+		addVariableLengthInteger(number);
+}
+
+void ProofWriter::endLine(LineKind const& kind, vector<ID> const* hints)
+{
+	//Derived clauses of a proof with hints have a second part, which is empty if the clause has to be checked by unit propagation
+	bool hasHintPart = isHinted && kind == LineKind::Lemma;
+	if (format == Format::Text)
+		buffer.insert(buffer.end(), { '0', hasHintPart ? ' ' : '\n' });
+	else
+		buffer.push_back(0);
+
+	if (hasHintPart)
+	{
+		if (hints != nullptr)
+			for (auto& hint : *hints)
+				addNumber(hint);
+
+		if (format == Format::Text)
+			buffer.insert(buffer.end(), { '0', '\n' });
+		else
+			buffer.push_back(0);
+	}
+
+	if (buffer.size() >= bufferSize)
+		handOver();
+}
+
+void ProofWriter::addVariableLengthInteger(uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back((char)((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back((char)value);
+}
+
+void ProofWriter::handOver()
+{
+	unique_lock<mutex> lock(bufferMutex);
+	bufferChanged.wait(lock, [this] { return !hasPendingBuffer; });
+	buffer.swap(pendingBuffer);
+	hasPendingBuffer = true;
+	lock.unlock();
+	bufferChanged.notify_all();
+}
+
+void ProofWriter::writePendingBuffers()
+{
+	unique_lock<mutex> lock(bufferMutex);
+	while (true)
+	{
+		bufferChanged.wait(lock, [this] { return hasPendingBuffer || isClosing; });
+		if (!hasPendingBuffer)
+			return;
+
+		//The search thread only touches the pending buffer after it has been marked as written
+		lock.unlock();
+		if (!ferror(file))
+			fwrite(pendingBuffer.data(), 1, pendingBuffer.size(), file);
+		pendingBuffer.clear();
+		lock.lock();
+
+		hasPendingBuffer = false;
+		bufferChanged.notify_all();
+	}
+}
@@ -0,0 +1,53 @@
+#include "../../header/tools/SearchStatistics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fmt/core.h>
+
+SearchStatistics& SearchStatistics::operator+=(SearchStatistics const& other)
+{
+	decisions += other.decisions;
+	propagations += other.propagations;
+	conflicts += other.conflicts;
+	learnedClauses += other.learnedClauses;
+	learnedLiterals += other.learnedLiterals;
+	forgottenClauses += other.forgottenClauses;
+	peakLearnedClauses = max(peakLearnedClauses, other.peakLearnedClauses);
+	backjumps += other.backjumps;
+	backjumpDistance += other.backjumpDistance;
+	maximumBackjumpDistance = max(maximumBackjumpDistance, other.maximumBackjumpDistance);
+	watchMoves += other.watchMoves;
+	stabilityRecomputations += other.stabilityRecomputations;
+	return *this;
+}
+
+bool SearchStatistics::isEmpty() const
+{
+	return propagations == 0;
+}
+
+double SearchStatistics::getAverageLearnedClauseSize() const
+{
+	return learnedClauses == 0 ? 0 : (double)learnedLiterals / learnedClauses;
+}
+
+double SearchStatistics::getAverageBackjumpDistance() const
+{
+	return backjumps == 0 ? 0 : (double)backjumpDistance / backjumps;
+}
+
+void SearchStatistics::print() const
+{
+	printf("Decisions: %lu, propagations: %lu, conflicts: %lu\n", decisions, propagations, conflicts);
+	printf("Learned clauses: %lu (average size: %.2f, forgotten: %lu, peak: %lu)\n", learnedClauses, getAverageLearnedClauseSize(), forgottenClauses, peakLearnedClauses);
+	printf("Backjumps: %lu (average distance: %.2f, maximum: %lu)\n", backjumps, getAverageBackjumpDistance(), maximumBackjumpDistance);
+	printf("Watch moves: %lu, stability recomputations: %lu\n", watchMoves, stabilityRecomputations);
+}
+
+string SearchStatistics::toJson() const
+{
+	return fmt::format("{{\"decisions\": {}, \"propagations\": {}, \"conflicts\": {}, \"learnedClauses\": {}, \"averageLearnedClauseSize\": {:.3f}, \"forgottenClauses\": {}, "
+		"\"peakLearnedClauses\": {}, \"backjumps\": {}, \"averageBackjumpDistance\": {:.3f}, \"maximumBackjumpDistance\": {}, \"watchMoves\": {}, \"stabilityRecomputations\": {}}}",
+		decisions, propagations, conflicts, learnedClauses, getAverageLearnedClauseSize(), forgottenClauses, peakLearnedClauses, backjumps, getAverageBackjumpDistance(),
+		maximumBackjumpDistance, watchMoves, stabilityRecomputations);
+}
@@ -0,0 +1,74 @@
+#include "../../header/tools/SparseMatrix.hpp"
+#include <cassert>
+
+using namespace std;
+
+SparseMatrix::SparseMatrix(vector<size_t> const& rowSizes, bool const& isWeighted) : rowOffsets(rowSizes.size() + 1, 0)
+{
+	for (size_t row = 0; row < rowSizes.size(); row++)
+		rowOffsets[row + 1] = rowOffsets[row] + rowSizes[row];
+
+	columns.resize(rowOffsets.back());
+	if (isWeighted)
+		values.resize(rowOffsets.back());
+	fillPositions.assign(rowOffsets.begin(), rowOffsets.end() - 1);
+}
+
+void SparseMatrix::addEntry(ID const& row, ID const& column, double const& value)
+{
+	assert(row < fillPositions.size());
+	assert(fillPositions[row] < rowOffsets[row + 1]);
+
+	auto position = fillPositions[row]++;
+	columns[position] = column;
+	if (!values.empty())
+		values[position] = value;
+}
+
+size_t SparseMatrix::getNumberOfRows() const
+{
+	return rowOffsets.size() - 1;
+}
+
+size_t SparseMatrix::getNumberOfEntries() const
+{
+	return columns.size();
+}
+
+void SparseMatrix::multiply(vector<double> const& input, vector<double>& output, double const& scale) const
+{
+	assert(output.size() == getNumberOfRows());
+
+	auto const numberOfRows = (long long)getNumberOfRows();
+	auto const offsets = rowOffsets.data();
+	auto const entryColumns = columns.data();
+	auto const entryValues = values.data();
+	auto const in = input.data();
+	auto const out = output.data();
+
+	//The row lengths are skewed on most instances, thus we use guided scheduling. The inner loops are gathers that only vectorize if the target supports it
+	if (values.empty())
+	{
+		#pragma omp parallel for schedule(guided)
+		for (long long row = 0; row < numberOfRows; row++)
+		{
+			double sum = 0.0;
+			#pragma omp simd reduction(+:sum)
+			for (size_t entry = offsets[row]; entry < offsets[row + 1]; entry++)
+				sum += in[entryColumns[entry]];
+			out[row] = sum * scale;
+		}
+	}
+	else
+	{
+		#pragma omp parallel for schedule(guided)
+		for (long long row = 0; row < numberOfRows; row++)
+		{
+			double sum = 0.0;
+			#pragma omp simd reduction(+:sum)
+			for (size_t entry = offsets[row]; entry < offsets[row + 1]; entry++)
+				sum += entryValues[entry] * in[entryColumns[entry]];
+			out[row] = sum * scale;
+		}
+	}
+}
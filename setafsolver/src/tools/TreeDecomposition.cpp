@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <iterator>
+
+#include "../../header/tools/TreeDecomposition.hpp"
+#include "../../header/tools/Helper.hpp"
+
+optional<TreeDecomposition> TreeDecomposition::tryCompute(Instance& instance, size_t const& maximumWidth)
+{
+	auto numberOfArguments = instance.getNumberOfArguments();
+
+	//Every attack forms a clique in the primal graph, thus a large attack already exceeds the width
+	vector<vector<ID>> adjacency(numberOfArguments);
+	for (auto [begin, end] = instance.getAttackIterator(); begin != end; begin++)
+	{
+		if (begin->getMemberCount() > maximumWidth + 1)
+			return {};
+
+		for (auto [first, membersEnd] = begin->getMembersIterator(); first != membersEnd; first++)
+			for (auto second = first + 1; second != membersEnd; second++)
+			{
+				adjacency[first->first->getId()].push_back(second->first->getId());
+				adjacency[second->first->getId()].push_back(first->first->getId());
+			}
+	}
+
+	//Bucket queue by degree with lazy deletion. All degrees above the width share the last bucket, as such arguments are never eliminated
+	vector<vector<ID>> buckets(maximumWidth + 2);
+	auto bucketOf = [&](ID const& argument) { return min(adjacency[argument].size(), maximumWidth + 1); };
+	for (ID i = 0; i < numberOfArguments; i++)
+	{
+		sort(adjacency[i].begin(), adjacency[i].end());
+		adjacency[i].erase(unique(adjacency[i].begin(), adjacency[i].end()), adjacency[i].end());
+		buckets[bucketOf(i)].push_back(i);
+	}
+
+	TreeDecomposition decomposition;
+	decomposition.bags.reserve(numberOfArguments);
+	const size_t notEliminated = numeric_limits<size_t>::max();
+	vector<size_t> eliminationPositions(numberOfArguments, notEliminated);
+	vector<ID> merged;
+	while (decomposition.bags.size() < numberOfArguments)
+	{
+		Helper::throwExceptionIfReceivedSignal();
+
+		//Find the lowest non empty bucket, dropping the outdated entries
+		auto isValid = [&](ID const& argument, size_t const& bucket) { return eliminationPositions[argument] == notEliminated && bucketOf(argument) == bucket; };
+		size_t degree = 0;
+		for (;; degree++)
+		{
+			auto& bucket = buckets[degree];
+			while (!bucket.empty() && !isValid(bucket.back(), degree))
+				bucket.pop_back();
+			if (!bucket.empty())
+				break;
+		}
+		if (degree > maximumWidth)
+			return {};
+
+		//Among the first candidates with the lowest degree, choose the one that adds the fewest edges
+		const size_t maximumCandidates = 8;
+		auto& bucket = buckets[degree];
+		size_t chosen = bucket.size() - 1;
+		auto chosenFill = computeFill(adjacency, bucket[chosen]);
+		size_t candidates = 1;
+		for (size_t i = chosen; chosenFill != 0 && candidates < maximumCandidates && i-- > 0;)
+		{
+			if (!isValid(bucket[i], degree))
+				continue;
+
+			candidates++;
+			auto fill = computeFill(adjacency, bucket[i]);
+			if (fill < chosenFill)
+			{
+				chosen = i;
+				chosenFill = fill;
+			}
+		}
+
+		auto argument = bucket[chosen];
+		bucket[chosen] = bucket.back();
+		bucket.pop_back();
+
+		//Record the bag
+		eliminationPositions[argument] = decomposition.bags.size();
+		auto& neighbors = adjacency[argument];
+		auto& bag = decomposition.bags.emplace_back();
+		bag.reserve(neighbors.size() + 1);
+		bag.push_back(argument);
+		bag.insert(bag.end(), neighbors.begin(), neighbors.end());
+		decomposition.width = max(decomposition.width, neighbors.size());
+
+		//Turn the neighborhood into a clique and remove the argument
+		for (auto& neighbor : neighbors)
+		{
+			auto& neighborAdjacency = adjacency[neighbor];
+			merged.clear();
+			set_union(neighborAdjacency.begin(), neighborAdjacency.end(), neighbors.begin(), neighbors.end(), back_inserter(merged));
+			merged.erase(remove_if(merged.begin(), merged.end(), [&](ID const& id) { return id == neighbor || id == argument; }), merged.end());
+
+			auto previousBucket = bucketOf(neighbor);
+			neighborAdjacency.swap(merged);
+			if (bucketOf(neighbor) != previousBucket)
+				buckets[bucketOf(neighbor)].push_back(neighbor);
+		}
+		neighbors.clear();
+		neighbors.shrink_to_fit();
+	}
+
+	//The parent is the bag of the neighbor eliminated first
+	decomposition.parents.resize(numberOfArguments, noParent);
+	decomposition.children.resize(numberOfArguments);
+	for (size_t i = 0; i < decomposition.bags.size(); i++)
+	{
+		auto& bag = decomposition.bags[i];
+		for (auto member = bag.begin() + 1; member != bag.end(); member++)
+			decomposition.parents[i] = min(decomposition.parents[i], eliminationPositions[*member]);
+
+		if (decomposition.parents[i] != noParent)
+			decomposition.children[decomposition.parents[i]].push_back(i);
+	}
+
+	return decomposition;
+}
+
+size_t TreeDecomposition::computeFill(vector<vector<ID>> const& adjacency, ID const& argument)
+{
+	size_t fill = 0;
+	auto& neighbors = adjacency[argument];
+	for (auto first = neighbors.begin(); first != neighbors.end(); first++)
+		for (auto second = first + 1; second != neighbors.end(); second++)
+			if (!binary_search(adjacency[*first].begin(), adjacency[*first].end(), *second))
+				fill++;
+	return fill;
+}
+
+size_t TreeDecomposition::getNumberOfBags() const
+{
+	return bags.size();
+}
+
+vector<ID> const& TreeDecomposition::getBag(size_t const& index) const
+{
+	return bags[index];
+}
+
+size_t TreeDecomposition::getParent(size_t const& index) const
+{
+	return parents[index];
+}
+
+vector<size_t> const& TreeDecomposition::getChildren(size_t const& index) const
+{
+	return children[index];
+}
+
+size_t TreeDecomposition::getWidth() const
+{
+	return width;
+}
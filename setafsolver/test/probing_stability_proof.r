@@ -0,0 +1 @@
+-31